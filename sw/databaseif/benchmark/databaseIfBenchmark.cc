@@ -0,0 +1,678 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <variant>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "databaseIf.h"
+
+using namespace DbEngine::DatabaseIf::V1;
+
+struct BenchmarkConfig
+{
+	uint32_t numberOfEntries {10000};
+	uint32_t keyDepth {5};
+	uint32_t arrayLength {4};
+	std::string typeMix {""}; // Passed to textDbGenerator -m as is, empty for all types
+	uint32_t numberOfThreads {4};
+	uint64_t maxIterations {100000};
+	uint32_t timeBudgetMs {500};
+	uint64_t seed {1};
+	std::string workDir {"/tmp/dbengine-benchmark"};
+	std::string textToBinPath {""};
+	std::string textDbGeneratorPath {""};
+	std::string outputFormat {"text"};
+};
+
+struct GeneratedEntry
+{
+	std::string key;
+	std::string partialKey; // The last two sub-keys only, e.g. /sensor3/voltageMask42
+	std::string type;
+	bool isWritable {true};
+};
+
+struct BenchmarkResult
+{
+	std::string name;
+	uint32_t threads {1};
+	uint64_t ops {0};
+	uint64_t failedOps {0};
+	double nsPerOp {0};
+	double opsPerSec {0};
+};
+
+using Clock = std::chrono::steady_clock;
+
+/* Format: ./databaseIfBenchmark -b <path_to_textToBin> -g <path_to_textDbGenerator> [options]		*/
+/* Options:												*/
+/* 	+ b: path to the textToBin executable used to compile the synthetic database			*/
+/* 	+ g: path to the textDbGenerator executable used to generate the synthetic database		*/
+/* 	+ n: number of entries of the synthetic database (default 10000)				*/
+/* 	+ d: maximum number of sub-keys per key, at least 3 (default 5)					*/
+/* 	+ a: maximum number of values per entry (default 4)						*/
+/* 	+ m: weighted type mix, e.g. U8:3,U16,CHAR (default all types)					*/
+/* 	+ t: number of threads of multi-threaded benchmarks (default 4)					*/
+/* 	+ i: maximum iterations per benchmark and thread (default 100000)				*/
+/* 	+ T: time budget per benchmark in milliseconds (default 500)					*/
+/* 	+ s: seed of the synthetic database and of the access pattern (default 1)			*/
+/* 	+ w: working directory of the synthetic database (default /tmp/dbengine-benchmark)		*/
+/* 	+ f: output format text, csv or json (default text)						*/
+void printUsage(const char* program);
+std::vector<GeneratedEntry> generateTextDb(const BenchmarkConfig& cfg, const std::string& txtFilePath);
+BenchmarkResult runBenchmark(const std::string& name, uint32_t threads, const BenchmarkConfig& cfg, const std::function<bool(uint32_t, uint64_t)>& op);
+bool getByType(const std::string& key, const std::string& type);
+bool getIntoByType(const std::string& key, const std::string& type);
+bool getManyByType(const std::vector<const GeneratedEntry*>& entries);
+bool getScalarByType(const std::string& key, const std::string& type);
+bool setScalarByType(const std::string& key, const std::string& type, uint64_t value);
+bool fetchAddByType(const std::string& key, const std::string& type);
+bool updateByType(const std::string& key, const std::string& type, bool isHardWrite);
+void printResults(const std::vector<BenchmarkResult>& results, const BenchmarkConfig& cfg);
+
+int main(int argc, char* argv[])
+{
+	BenchmarkConfig cfg;
+	int opt = 0;
+
+	while((opt = getopt(argc, argv, "b:g:n:d:a:m:t:i:T:s:w:f:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'b':
+			cfg.textToBinPath = std::string(optarg);
+			break;
+		case 'g':
+			cfg.textDbGeneratorPath = std::string(optarg);
+			break;
+		case 'n':
+			cfg.numberOfEntries = std::stoul(optarg);
+			break;
+		case 'd':
+			cfg.keyDepth = std::max(3ul, std::stoul(optarg));
+			break;
+		case 'a':
+			cfg.arrayLength = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'm':
+			cfg.typeMix = std::string(optarg);
+			break;
+		case 't':
+			cfg.numberOfThreads = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'i':
+			cfg.maxIterations = std::max(1ull, std::stoull(optarg));
+			break;
+		case 'T':
+			cfg.timeBudgetMs = std::stoul(optarg);
+			break;
+		case 's':
+			cfg.seed = std::stoull(optarg);
+			break;
+		case 'w':
+			cfg.workDir = std::string(optarg);
+			break;
+		case 'f':
+			cfg.outputFormat = std::string(optarg);
+			break;
+		default:
+			printUsage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if(cfg.textToBinPath.empty() || cfg.textDbGeneratorPath.empty() || cfg.numberOfEntries == 0)
+	{
+		printUsage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	// Compile the synthetic database and point DbLoader at it, must happen before the first DB access
+	mkdir(cfg.workDir.c_str(), 0755);
+	const std::string txtFilePath = cfg.workDir + "/swdb.txt";
+	const std::string binFilePath = cfg.workDir + "/swdb.bin";
+	std::remove(std::string(cfg.workDir + "/swdb-hardsave.bin").c_str());
+
+	std::vector<GeneratedEntry> entries = generateTextDb(cfg, txtFilePath);
+	const std::string command = cfg.textToBinPath + " -i " + txtFilePath + " -o " + binFilePath + " > /dev/null";
+	if(std::system(command.c_str()) != 0)
+	{
+		std::cout << "ERROR: Failed to compile the synthetic database: " << command << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	setenv("DBENGINE_SWDB_DIR", cfg.workDir.c_str(), 1);
+
+	std::map<std::string, std::vector<const GeneratedEntry*>> entriesByType;
+	std::vector<const GeneratedEntry*> allEntries;
+	std::vector<const GeneratedEntry*> writableEntries;
+	std::vector<const GeneratedEntry*> scalarEntries; // Single values of up to 32 bits, only with -a 1
+	std::vector<const GeneratedEntry*> writableScalarEntries;
+	for(const auto& e : entries)
+	{
+		allEntries.push_back(&e);
+		entriesByType[e.type].push_back(&e);
+		if(e.isWritable) writableEntries.push_back(&e);
+		const bool isScalar = cfg.arrayLength == 1 && e.type != "CHAR" && e.type != "U64" && e.type != "S64";
+		if(isScalar) scalarEntries.push_back(&e);
+		if(isScalar && e.isWritable) writableScalarEntries.push_back(&e);
+	}
+
+	std::vector<BenchmarkResult> results;
+	IDatabase& db = IDatabase::getInstance();
+
+	// The first access constructs DbLoader, which loads and parses swdb.bin
+	{
+		const auto start = Clock::now();
+		std::vector<uint8_t> values;
+		(void)db.get(entries.front().key, values);
+		BenchmarkResult load;
+		load.name = "load";
+		load.ops = 1;
+		load.nsPerOp = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		load.opsPerSec = 1e9 / load.nsPerOp;
+		results.push_back(load);
+
+		// Breakdown of the load as measured by DbLoader itself
+		const LoadStats loadStats = db.loadStats();
+		const std::pair<const char*, uint64_t> phases[] = {{"load_file_read", loadStats.fileReadNs}, {"load_crc", loadStats.crcNs},
+			{"load_keys", loadStats.keyParsingNs}, {"load_values", loadStats.valueConversionNs}, {"load_dictionary", loadStats.dictionaryNs},
+			{"load_hardsave", loadStats.hardSaveReplayNs}};
+		for(const auto& [name, ns] : phases)
+		{
+			BenchmarkResult phase;
+			phase.name = name;
+			phase.ops = 1;
+			phase.nsPerOp = ns;
+			phase.opsPerSec = ns ? 1e9 / ns : 0;
+			results.push_back(phase);
+		}
+	}
+
+	auto pick = [&cfg](const auto& pool, uint32_t thread, uint64_t i) -> const GeneratedEntry& {
+		// Cheap deterministic scattering of the access pattern (splitmix64 finalizer), different for every thread
+		uint64_t x = i + (cfg.seed + thread) * 0x9E3779B97F4A7C15ull;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		x ^= x >> 31;
+		return *pool[x % pool.size()];
+	};
+
+	for(const auto& [type, pool] : entriesByType)
+	{
+		results.push_back(runBenchmark("get_hit_" + type, 1, cfg, [&, &pool = pool, &type = type](uint32_t t, uint64_t i){
+			return getByType(pick(pool, t, i).key, type);
+		}));
+	}
+
+	results.push_back(runBenchmark("get_miss", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return !getByType(e.key + "_missing", e.type);
+	}));
+
+	results.push_back(runBenchmark("get_type_mismatch", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return !getByType(e.key, e.type == "U8" ? "S8" : "U8");
+	}));
+
+	// Misses and type mismatches emit traces, run them again with every trace point compiled in but disabled at runtime
+	db.setTraceLevel(TraceLevel::NONE);
+	results.push_back(runBenchmark("get_miss_trace_off", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return !getByType(e.key + "_missing", e.type);
+	}));
+
+	results.push_back(runBenchmark("get_type_mismatch_trace_off", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return !getByType(e.key, e.type == "U8" ? "S8" : "U8");
+	}));
+	db.setTraceLevel(TraceLevel::INFO);
+
+	results.push_back(runBenchmark("get_partial_path", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return getByType(e.partialKey, e.type);
+	}));
+
+	results.push_back(runBenchmark("get_hit_mixed", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return getByType(e.key, e.type);
+	}));
+
+	// Same as get_hit_mixed with statistics on, the difference is the cost of collecting them
+	db.enableStats(true);
+	results.push_back(runBenchmark("get_hit_mixed_stats", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return getByType(e.key, e.type);
+	}));
+	db.enableStats(false);
+
+	// Same as get_hit_mixed on a small hot set with the per-thread read cache on, no write invalidates it meanwhile
+	const std::vector<const GeneratedEntry*> hotEntries(allEntries.begin(), allEntries.begin() + std::min<std::size_t>(32, allEntries.size()));
+	db.enableReadCache(64);
+	results.push_back(runBenchmark("get_hot_cached", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(hotEntries, t, i);
+		return getByType(e.key, e.type);
+	}));
+	db.enableReadCache(0);
+	results.push_back(runBenchmark("get_hot_uncached", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(hotEntries, t, i);
+		return getByType(e.key, e.type);
+	}));
+
+	// Same as get_hit_mixed through the allocation-free get() into fixed buffers
+	results.push_back(runBenchmark("get_hit_mixed_realtime", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		return getIntoByType(e.key, e.type);
+	}));
+
+	if(!scalarEntries.empty())
+	{
+		results.push_back(runBenchmark("get_scalar_mixed", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+			const auto& e = pick(scalarEntries, t, i);
+			return getScalarByType(e.key, e.type);
+		}));
+	}
+
+	// Visit the siblings of a random entry, i.e. everything under the parent of its key
+	results.push_back(runBenchmark("scan_parent", 1, cfg, [&](uint32_t t, uint64_t i){
+		const auto& e = pick(allEntries, t, i);
+		std::size_t numberOfValues = 0;
+		const std::size_t numberOfVisits = db.scan(std::string_view(e.key).substr(0, e.key.rfind('/')), [&](const ScanEntry& entry){
+			numberOfValues += entry.size();
+			return true;
+		});
+		return numberOfVisits > 0 && numberOfValues > 0;
+	}));
+
+	// The same batches of keys through one getMany() or one get() per key, an op is a whole batch
+	constexpr uint64_t BATCH_SIZE = 100;
+	results.push_back(runBenchmark("get_single_batch_100", 1, cfg, [&](uint32_t t, uint64_t i){
+		bool isOk = true;
+		for(uint64_t k = 0; k < BATCH_SIZE; ++k)
+		{
+			const auto& e = pick(allEntries, t, i * BATCH_SIZE + k);
+			isOk = getByType(e.key, e.type) && isOk;
+		}
+		return isOk;
+	}));
+
+	results.push_back(runBenchmark("get_many_batch_100", 1, cfg, [&](uint32_t t, uint64_t i){
+		std::vector<const GeneratedEntry*> batch;
+		for(uint64_t k = 0; k < BATCH_SIZE; ++k)
+		{
+			batch.push_back(&pick(allEntries, t, i * BATCH_SIZE + k));
+		}
+		return getManyByType(batch);
+	}));
+
+	if(!writableEntries.empty())
+	{
+		results.push_back(runBenchmark("update_soft", 1, cfg, [&](uint32_t t, uint64_t i){
+			const auto& e = pick(writableEntries, t, i);
+			return updateByType(e.key, e.type, false);
+		}));
+
+		results.push_back(runBenchmark("get_hit_modified", 1, cfg, [&](uint32_t t, uint64_t i){
+			const auto& e = pick(writableEntries, t, i);
+			return getByType(e.key, e.type);
+		}));
+
+		// Once a key has its Modified DB entry, its next soft writes are done in place
+		if(!writableScalarEntries.empty())
+		{
+			for(const auto* e : writableScalarEntries)
+			{
+				(void)setScalarByType(e->key, e->type, 0);
+			}
+			results.push_back(runBenchmark("set_scalar_soft", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+				const auto& e = pick(writableScalarEntries, t, i);
+				return setScalarByType(e.key, e.type, i % 100);
+			}));
+			results.push_back(runBenchmark("fetch_add_soft", cfg.numberOfThreads, cfg, [&](uint32_t t, uint64_t i){
+				const auto& e = pick(writableScalarEntries, t, i);
+				return fetchAddByType(e.key, e.type);
+			}));
+			// Every thread increments the same counter
+			results.push_back(runBenchmark("fetch_add_shared", cfg.numberOfThreads, cfg, [&](uint32_t, uint64_t){
+				return fetchAddByType(writableScalarEntries.front()->key, writableScalarEntries.front()->type);
+			}));
+		}
+
+		// Every hard write rewrites swdb-hardsave.bin, so it gets far fewer iterations
+		BenchmarkConfig hardCfg = cfg;
+		hardCfg.maxIterations = std::max<uint64_t>(10, cfg.maxIterations / 100);
+		results.push_back(runBenchmark("update_hard", 1, hardCfg, [&](uint32_t t, uint64_t i){
+			const auto& e = pick(writableEntries, t, i);
+			return updateByType(e.key, e.type, true);
+		}));
+	}
+
+	(void)db.reset();
+
+	// Erase distinct keys, then restore exactly the same keys
+	const uint64_t eraseCount = std::min<uint64_t>(entries.size(), cfg.maxIterations);
+	BenchmarkConfig eraseCfg = cfg;
+	eraseCfg.maxIterations = eraseCount;
+	BenchmarkResult eraseResult = runBenchmark("erase", 1, eraseCfg, [&](uint32_t, uint64_t i){
+		return db.erase(entries[i].key).getRawEnum() == ReturnCodeRaw::OK;
+	});
+	results.push_back(eraseResult);
+
+	eraseCfg.maxIterations = eraseResult.ops;
+	eraseCfg.timeBudgetMs = 0; // Restore all erased keys, whatever it costs
+	results.push_back(runBenchmark("restore", 1, eraseCfg, [&](uint32_t, uint64_t i){
+		return db.restore(entries[i].key).getRawEnum() == ReturnCodeRaw::OK;
+	}));
+
+	// Each reset is measured with a few soft-modified keys, which is the usual case
+	BenchmarkConfig resetCfg = cfg;
+	resetCfg.maxIterations = std::max<uint64_t>(10, cfg.maxIterations / 100);
+	results.push_back(runBenchmark("reset", 1, resetCfg, [&](uint32_t t, uint64_t i){
+		if(!writableEntries.empty())
+		{
+			const auto& e = pick(writableEntries, t, i);
+			(void)updateByType(e.key, e.type, false);
+		}
+		return db.reset().getRawEnum() == ReturnCodeRaw::OK;
+	}));
+
+	printResults(results, cfg);
+
+	exit(EXIT_SUCCESS);
+}
+
+void printUsage(const char* program)
+{
+	std::cout << "ERROR:\n";
+	std::cout << "\tUsage:  " << program << " -b <path_to_textToBin> -g <path_to_textDbGenerator> [-n entries] [-d depth] [-a values] [-m types] [-t threads] [-i iterations] [-T ms] [-s seed] [-w dir] [-f text|csv|json]\n";
+	std::cout << "\tOption:\n";
+	std::cout << "\t\t -b : path to the textToBin executable.\n";
+	std::cout << "\t\t -g : path to the textDbGenerator executable.\n";
+	std::cout << "\t\t -n : number of entries of the synthetic database.\n";
+	std::cout << "\t\t -d : maximum number of sub-keys per key, at least 3.\n";
+	std::cout << "\t\t -a : maximum number of values per entry.\n";
+	std::cout << "\t\t -m : weighted type mix, e.g. U8:3,U16,CHAR.\n";
+	std::cout << "\t\t -t : number of threads of multi-threaded benchmarks.\n";
+	std::cout << "\t\t -i : maximum iterations per benchmark and thread.\n";
+	std::cout << "\t\t -T : time budget per benchmark in milliseconds.\n";
+	std::cout << "\t\t -s : seed of the synthetic database and access pattern.\n";
+	std::cout << "\t\t -w : working directory of the synthetic database.\n";
+	std::cout << "\t\t -f : output format, text, csv or json.\n";
+}
+
+std::vector<GeneratedEntry> generateTextDb(const BenchmarkConfig& cfg, const std::string& txtFilePath)
+{
+	// Wildcard keys are left out, every benchmark addresses the keys exactly as written
+	std::string command = cfg.textDbGeneratorPath + " -o " + txtFilePath + " -n " + std::to_string(cfg.numberOfEntries) + " -d "
+		+ std::to_string(cfg.keyDepth) + " -a " + std::to_string(cfg.arrayLength) + " -w 0 -s " + std::to_string(cfg.seed);
+	if(!cfg.typeMix.empty()) command += " -m " + cfg.typeMix;
+	command += " > /dev/null";
+	if(std::system(command.c_str()) != 0)
+	{
+		std::cout << "ERROR: Failed to generate the synthetic database: " << command << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	std::ifstream txtFile(txtFilePath);
+	if(!txtFile.is_open())
+	{
+		std::cout << "ERROR: Failed to open file: " << txtFilePath << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	std::vector<GeneratedEntry> entries;
+	entries.reserve(cfg.numberOfEntries);
+
+	// Every line which is neither empty nor a comment is <key> <permission> <type> <values>
+	std::string line;
+	while(std::getline(txtFile, line))
+	{
+		if(line.empty() || line.rfind("/*", 0) == 0) continue;
+
+		GeneratedEntry e;
+		std::string permission;
+		std::istringstream(line) >> e.key >> permission >> e.type;
+		e.isWritable = permission == "RW";
+		e.partialKey = e.key.substr(e.key.rfind('/', e.key.rfind('/') - 1)); // The last two sub-keys only
+		entries.push_back(std::move(e));
+	}
+
+	return entries;
+}
+
+template<typename T>
+bool getTyped(const std::string& key)
+{
+	std::vector<T> values;
+	return IDatabase::getInstance().get(key, values).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+bool getByType(const std::string& key, const std::string& type)
+{
+	if(type == "U8") return getTyped<uint8_t>(key);
+	else if(type == "S8") return getTyped<int8_t>(key);
+	else if(type == "U16") return getTyped<uint16_t>(key);
+	else if(type == "S16") return getTyped<int16_t>(key);
+	else if(type == "U32") return getTyped<uint32_t>(key);
+	else if(type == "S32") return getTyped<int32_t>(key);
+	else if(type == "U64") return getTyped<uint64_t>(key);
+	else if(type == "S64") return getTyped<int64_t>(key);
+	else if(type == "CHAR") return getTyped<std::string>(key);
+	return false;
+}
+
+template<typename T>
+bool getIntoTyped(const std::string& key)
+{
+	T values[256];
+	std::size_t count = 0;
+	return IDatabase::getInstance().get(key, values, count).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+bool getIntoByType(const std::string& key, const std::string& type)
+{
+	if(type == "U8") return getIntoTyped<uint8_t>(key);
+	else if(type == "S8") return getIntoTyped<int8_t>(key);
+	else if(type == "U16") return getIntoTyped<uint16_t>(key);
+	else if(type == "S16") return getIntoTyped<int16_t>(key);
+	else if(type == "U32") return getIntoTyped<uint32_t>(key);
+	else if(type == "S32") return getIntoTyped<int32_t>(key);
+	else if(type == "U64") return getIntoTyped<uint64_t>(key);
+	else if(type == "S64") return getIntoTyped<int64_t>(key);
+	else if(type == "CHAR") return getIntoTyped<char>(key);
+	return false;
+}
+
+bool getManyByType(const std::vector<const GeneratedEntry*>& entries)
+{
+	using Values = std::variant<std::vector<uint8_t>, std::vector<int8_t>, std::vector<uint16_t>, std::vector<int16_t>, std::vector<uint32_t>,
+		std::vector<int32_t>, std::vector<uint64_t>, std::vector<int64_t>, std::vector<std::string>>;
+
+	std::vector<Values> outputs(entries.size());
+	std::vector<GetRequest> requests(entries.size());
+	for(std::size_t k = 0; k < entries.size(); ++k)
+	{
+		const std::string& type = entries[k]->type;
+		if(type == "U8") outputs[k].emplace<std::vector<uint8_t>>();
+		else if(type == "S8") outputs[k].emplace<std::vector<int8_t>>();
+		else if(type == "U16") outputs[k].emplace<std::vector<uint16_t>>();
+		else if(type == "S16") outputs[k].emplace<std::vector<int16_t>>();
+		else if(type == "U32") outputs[k].emplace<std::vector<uint32_t>>();
+		else if(type == "S32") outputs[k].emplace<std::vector<int32_t>>();
+		else if(type == "U64") outputs[k].emplace<std::vector<uint64_t>>();
+		else if(type == "S64") outputs[k].emplace<std::vector<int64_t>>();
+		else if(type == "CHAR") outputs[k].emplace<std::vector<std::string>>();
+
+		requests[k].key = entries[k]->key;
+		std::visit([&request = requests[k]](auto& values){ request.values = &values; }, outputs[k]);
+	}
+
+	return IDatabase::getInstance().getMany(requests).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+template<typename T>
+bool getScalarTyped(const std::string& key)
+{
+	T value {};
+	return IDatabase::getInstance().getScalar(key, value).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+bool getScalarByType(const std::string& key, const std::string& type)
+{
+	if(type == "U8") return getScalarTyped<uint8_t>(key);
+	else if(type == "S8") return getScalarTyped<int8_t>(key);
+	else if(type == "U16") return getScalarTyped<uint16_t>(key);
+	else if(type == "S16") return getScalarTyped<int16_t>(key);
+	else if(type == "U32") return getScalarTyped<uint32_t>(key);
+	else if(type == "S32") return getScalarTyped<int32_t>(key);
+	else if(type == "U64") return getScalarTyped<uint64_t>(key);
+	else if(type == "S64") return getScalarTyped<int64_t>(key);
+	return false;
+}
+
+bool setScalarByType(const std::string& key, const std::string& type, uint64_t value)
+{
+	IDatabase& db = IDatabase::getInstance();
+	ReturnCodeEnum rc(ReturnCodeRaw::UNDEFINED);
+	if(type == "U8") rc = db.setScalar(key, static_cast<uint8_t>(value));
+	else if(type == "S8") rc = db.setScalar(key, static_cast<int8_t>(value));
+	else if(type == "U16") rc = db.setScalar(key, static_cast<uint16_t>(value));
+	else if(type == "S16") rc = db.setScalar(key, static_cast<int16_t>(value));
+	else if(type == "U32") rc = db.setScalar(key, static_cast<uint32_t>(value));
+	else if(type == "S32") rc = db.setScalar(key, static_cast<int32_t>(value));
+	else if(type == "U64") rc = db.setScalar(key, static_cast<uint64_t>(value));
+	else if(type == "S64") rc = db.setScalar(key, static_cast<int64_t>(value));
+	return rc.getRawEnum() == ReturnCodeRaw::OK;
+}
+
+template<typename T>
+bool fetchAddTyped(const std::string& key)
+{
+	T previousValue {};
+	return IDatabase::getInstance().fetchAdd(key, T {1}, previousValue).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+bool fetchAddByType(const std::string& key, const std::string& type)
+{
+	if(type == "U8") return fetchAddTyped<uint8_t>(key);
+	else if(type == "S8") return fetchAddTyped<int8_t>(key);
+	else if(type == "U16") return fetchAddTyped<uint16_t>(key);
+	else if(type == "S16") return fetchAddTyped<int16_t>(key);
+	else if(type == "U32") return fetchAddTyped<uint32_t>(key);
+	else if(type == "S32") return fetchAddTyped<int32_t>(key);
+	else if(type == "U64") return fetchAddTyped<uint64_t>(key);
+	else if(type == "S64") return fetchAddTyped<int64_t>(key);
+	return false;
+}
+
+template<typename T>
+bool updateTyped(const std::string& key, bool isHardWrite)
+{
+	std::vector<T> values;
+	if(IDatabase::getInstance().get(key, values).getRawEnum() != ReturnCodeRaw::OK) return false;
+	if constexpr(std::is_same<T, std::string>::value) values.pop_back(); // Drop the complete string stored at last
+	return IDatabase::getInstance().update(key, values, isHardWrite).getRawEnum() == ReturnCodeRaw::OK;
+}
+
+bool updateByType(const std::string& key, const std::string& type, bool isHardWrite)
+{
+	if(type == "U8") return updateTyped<uint8_t>(key, isHardWrite);
+	else if(type == "S8") return updateTyped<int8_t>(key, isHardWrite);
+	else if(type == "U16") return updateTyped<uint16_t>(key, isHardWrite);
+	else if(type == "S16") return updateTyped<int16_t>(key, isHardWrite);
+	else if(type == "U32") return updateTyped<uint32_t>(key, isHardWrite);
+	else if(type == "S32") return updateTyped<int32_t>(key, isHardWrite);
+	else if(type == "U64") return updateTyped<uint64_t>(key, isHardWrite);
+	else if(type == "S64") return updateTyped<int64_t>(key, isHardWrite);
+	else if(type == "CHAR") return updateTyped<std::string>(key, isHardWrite);
+	return false;
+}
+
+BenchmarkResult runBenchmark(const std::string& name, uint32_t threads, const BenchmarkConfig& cfg, const std::function<bool(uint32_t, uint64_t)>& op)
+{
+	std::atomic<uint64_t> totalOps {0};
+	std::atomic<uint64_t> totalFailedOps {0};
+	const auto budget = std::chrono::milliseconds(cfg.timeBudgetMs);
+
+	auto worker = [&](uint32_t t){
+		uint64_t ops = 0;
+		uint64_t failedOps = 0;
+		const auto start = Clock::now();
+		for(uint64_t i = 0; i < cfg.maxIterations; ++i)
+		{
+			if(!op(t, i)) ++failedOps;
+			++ops;
+
+			// Checking the clock every 64 ops keeps its cost out of the measurement
+			if(cfg.timeBudgetMs && (i & 63) == 63 && Clock::now() - start > budget) break;
+		}
+		totalOps += ops;
+		totalFailedOps += failedOps;
+	};
+
+	const auto start = Clock::now();
+	if(threads == 1)
+	{
+		worker(0);
+	}
+	else
+	{
+		std::vector<std::thread> workers;
+		for(uint32_t t = 0; t < threads; ++t) workers.emplace_back(worker, t);
+		for(auto& w : workers) w.join();
+	}
+	const double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+	BenchmarkResult result;
+	result.name = name;
+	result.threads = threads;
+	result.ops = totalOps;
+	result.failedOps = totalFailedOps;
+	result.nsPerOp = result.ops ? elapsedNs * threads / result.ops : 0; // Latency seen by one thread
+	result.opsPerSec = elapsedNs > 0 ? result.ops * 1e9 / elapsedNs : 0; // Throughput of all threads together
+	return result;
+}
+
+void printResults(const std::vector<BenchmarkResult>& results, const BenchmarkConfig& cfg)
+{
+	if(cfg.outputFormat == "json")
+	{
+		// One JSON object per line, easy to diff and to load in any dashboard
+		for(const auto& r : results)
+		{
+			std::cout << std::fixed << std::setprecision(1)
+				<< "{\"name\":\"" << r.name << "\",\"entries\":" << cfg.numberOfEntries << ",\"depth\":" << cfg.keyDepth
+				<< ",\"threads\":" << r.threads << ",\"ops\":" << r.ops << ",\"failed_ops\":" << r.failedOps
+				<< ",\"ns_per_op\":" << r.nsPerOp << ",\"ops_per_sec\":" << r.opsPerSec << "}" << std::endl;
+		}
+	}
+	else if(cfg.outputFormat == "csv")
+	{
+		std::cout << "name,entries,depth,threads,ops,failed_ops,ns_per_op,ops_per_sec" << std::endl;
+		for(const auto& r : results)
+		{
+			std::cout << std::fixed << std::setprecision(1) << r.name << "," << cfg.numberOfEntries << "," << cfg.keyDepth << ","
+				<< r.threads << "," << r.ops << "," << r.failedOps << "," << r.nsPerOp << "," << r.opsPerSec << std::endl;
+		}
+	}
+	else
+	{
+		std::cout << "Synthetic DB: " << cfg.numberOfEntries << " entries, depth up to " << cfg.keyDepth << ", up to " << cfg.arrayLength << " values per entry, seed " << cfg.seed << std::endl;
+		std::cout << std::left << std::setw(30) << "benchmark" << std::right << std::setw(8) << "threads" << std::setw(12) << "ops"
+			<< std::setw(10) << "failed" << std::setw(16) << "ns/op" << std::setw(16) << "ops/s" << std::endl;
+		for(const auto& r : results)
+		{
+			std::cout << std::fixed << std::setprecision(1) << std::left << std::setw(30) << r.name << std::right << std::setw(8) << r.threads
+				<< std::setw(12) << r.ops << std::setw(10) << r.failedOps << std::setw(16) << r.nsPerOp << std::setw(16) << r.opsPerSec << std::endl;
+		}
+	}
+}
@@ -11,7 +11,16 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <variant>
+#include <any>
+#include <functional>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
 
 #include <enumUtils.h>
 
@@ -30,6 +39,10 @@ enum class ReturnCodeRaw
 	KEY_NOT_FOUND,
 	TYPE_MISMATCH,
 	NOT_WRITABLE,
+	BUFFER_TOO_SMALL,
+	VALUE_MISMATCH,
+	UNCHANGED,
+	DB_MISMATCH,
 	UNDEFINED
 };
 
@@ -55,6 +68,18 @@ public:
 		case ReturnCodeRaw::NOT_WRITABLE:
 			return "NOT_WRITABLE";
 
+		case ReturnCodeRaw::BUFFER_TOO_SMALL:
+			return "BUFFER_TOO_SMALL";
+
+		case ReturnCodeRaw::VALUE_MISMATCH:
+			return "VALUE_MISMATCH";
+
+		case ReturnCodeRaw::UNCHANGED:
+			return "UNCHANGED";
+
+		case ReturnCodeRaw::DB_MISMATCH:
+			return "DB_MISMATCH";
+
 		case ReturnCodeRaw::UNDEFINED:
 			return "UNDEFINED";
 
@@ -64,6 +89,259 @@ public:
 	}
 };
 
+// Type of a DB entry, as declared in the text DB
+enum class ValueType
+{
+	UNDEFINED,
+	U8,
+	S8,
+	U16,
+	S16,
+	U32,
+	S32,
+	U64,
+	S64,
+	CHAR
+};
+
+// Minimum level of the traces emitted by the database, see IDatabase::setTraceLevel()
+enum class TraceLevel
+{
+	INFO,
+	ABN,
+	ERROR,
+	NONE
+};
+
+// Latency histogram with log-linear buckets like HdrHistogram: 4 buckets per power of two, so every bucket is at most 25% wide.
+// Bucket i counts latencies in [getLowerBoundNs(i), getLowerBoundNs(i + 1)), the last bucket also counts everything above ~18 minutes.
+struct LatencyHistogram
+{
+	static constexpr std::size_t NUMBER_OF_BUCKETS = 160;
+
+	std::array<uint64_t, NUMBER_OF_BUCKETS> buckets {};
+	uint64_t count {0};
+	uint64_t totalNs {0};
+	uint64_t maxNs {0};
+
+	static std::size_t getBucket(uint64_t ns)
+	{
+		if(ns < 4) return ns;
+		const std::size_t msb = 63 - __builtin_clzll(ns);
+		const std::size_t bucket = (msb - 1) * 4 + ((ns >> (msb - 2)) & 3);
+		return bucket < NUMBER_OF_BUCKETS ? bucket : NUMBER_OF_BUCKETS - 1;
+	}
+
+	static uint64_t getLowerBoundNs(std::size_t bucket)
+	{
+		if(bucket < 4) return bucket;
+		return (4ull + bucket % 4) << (bucket / 4 - 1);
+	}
+
+	double getMeanNs() const
+	{
+		return count ? static_cast<double>(totalNs) / count : 0;
+	}
+
+	// Upper bound of the bucket which holds the given percentile (0-100), never above maxNs
+	uint64_t getPercentileNs(double percentile) const
+	{
+		const uint64_t rank = static_cast<uint64_t>(percentile / 100 * count + 0.5);
+		uint64_t seen = 0;
+		for(std::size_t i = 0; i < NUMBER_OF_BUCKETS; ++i)
+		{
+			seen += buckets[i];
+			if(seen > 0 && seen >= rank) return std::min(getLowerBoundNs(i + 1) - 1, maxNs);
+		}
+		return maxNs;
+	}
+};
+
+// Snapshot of the statistics collected by the database, see IDatabase::stats().
+// Counters are summed up from per-thread shards without stopping other threads, so they are not one atomic snapshot.
+struct DatabaseStats
+{
+	bool isEnabled {false};
+
+	// Latency of every call, count included
+	LatencyHistogram get;
+	LatencyHistogram softUpdate;
+	LatencyHistogram hardUpdate;
+	LatencyHistogram erase;
+	LatencyHistogram restore;
+	LatencyHistogram reset;
+	LatencyHistogram getMany; // One sample per batch, its keys are counted below but not in get
+
+	uint64_t modifiedDbHits {0}; // Key found in the Modified DB
+	uint64_t originalDbHits {0}; // Key not in the Modified DB, found after falling back to the Original DB
+	uint64_t keyNotFound {0};
+	uint64_t typeMismatch {0};
+	uint64_t notWritable {0};
+
+	// Original DB misses rejected by the Bloom filter of its sub-keys without a dictionary lookup, and misses which passed it.
+	// filterFalsePositives / (filterRejects + filterFalsePositives) is the share of misses the filter did not catch.
+	uint64_t filterRejects {0};
+	uint64_t filterFalsePositives {0};
+
+	// get() answered from the read cache of the calling thread, without looking the key up, see IDatabase::enableReadCache()
+	uint64_t readCacheHits {0};
+
+	// Only contended lock acquisitions are timed, uncontended ones are just counted
+	uint64_t uncontendedLocks {0};
+	LatencyHistogram lockWait;
+};
+
+// Where the time and memory of loading the database at startup went, see IDatabase::loadStats(). All times are in ns.
+struct LoadStats
+{
+	bool isLoaded {false}; // swdb.bin was loaded successfully
+	bool isEmbedded {false}; // Loaded from the image linked into the executable instead of swdb.bin, see textToBin -c
+	uint32_t dbRevision {0};
+	uint64_t checksum {0}; // 64-bit FNV-1a hash of the DB payload, accessors generated by textToBin -g compare it with their DB_CHECKSUM
+	uint64_t fileBytes {0};
+	uint64_t numberOfEntries {0};
+	uint64_t numberOfUniqueValues {0}; // Entries with identical type and value share one parsed value
+	uint64_t numberOfHardSavedEntries {0};
+	uint64_t numberOfConversions {0}; // Numeric values converted by std::stoll
+	uint64_t numberOfConversionFailures {0}; // Values dropped because they were not numeric or out of range of their type
+	uint64_t arenaBytes {0}; // Bytes of interned keys and CHAR values
+
+	uint64_t totalNs {0};
+	uint64_t fileReadNs {0}; // Open and read swdb.bin (if not embedded) and check its header
+	uint64_t crcNs {0}; // CRC16 check and content hash of the payload
+	uint64_t keyParsingNs {0}; // Entry framing, permission, type and key interning
+	uint64_t valueConversionNs {0};
+	uint64_t dictionaryNs {0};
+	uint64_t hardSaveReplayNs {0}; // Everything about swdb-hardsave.bin
+
+	uint64_t peakRssKb {0}; // Peak resident set size of the process right after loading
+};
+
+// Heap used by the database, see IDatabase::memoryUsage(). Sizes of standard containers are estimated from their
+// capacities and node layouts (libstdc++), allocator overhead per allocation is not included.
+struct MemoryUsage
+{
+	struct Part
+	{
+		uint64_t count {0};
+		uint64_t bytes {0};
+	};
+
+	struct Db
+	{
+		Part entries; // Entry slots of the storage, bytes include unused capacity
+		Part arena; // Interned keys and CHAR values, only the keys replayed from swdb-hardsave.bin for the Modified DB
+		// Modified DB CHAR values include their strings, which are freed once no entry nor snapshot refers to them (rewrite, restore)
+		Part values; // Parsed values, shared values are counted once
+		std::map<std::string, Part> valuesPerType;
+		Part dictionaryTokens; // Sub-keys of the inverted index
+		Part dictionaryPostings; // Entry indices of all posting lists
+		Part keyIndex; // Radix tree nodes of the whole keys (keys are not copied), for the Modified DB the id of each copy
+		Part tokenFilter; // Bloom filter of the sub-keys, Original DB only
+		Part scalarSlots; // Atomic values of single-value entries of up to 32 bits, Original DB only
+		Part versionStamps; // DB version of the last change of each entry, Original DB only (copies share it)
+		Part erasedBits; // Erase state of each entry, count is the number of erased entries, Original DB only (copies share it)
+		uint64_t totalBytes {0};
+	};
+
+	Db original;
+	Db modified; // Overlay of soft/hard written and erased entries
+	std::map<std::string, Part> perPrefix; // Entries of both DBs by key prefix, bytes of their entry slots, keys and unshared values
+	uint64_t totalBytes {0};
+};
+
+// Frequently accessed key, estimated by a Space-Saving sketch from sampled accesses, see IDatabase::hotKeys().
+// count is scaled by the sampling period, count - error is a lower bound of the sampled accesses times the period.
+struct HotKey
+{
+	std::string key;
+	uint64_t count {0};
+	uint64_t error {0};
+};
+
+struct HotKeyReport
+{
+	uint32_t samplingPeriod {0}; // 0 if hot-key tracking is off
+	std::vector<HotKey> reads; // Successful get() calls
+	std::vector<HotKey> writes; // Successful update() calls
+	std::vector<HotKey> misses; // get() and update() calls returning KEY_NOT_FOUND
+};
+
+// One entry visited by IDatabase::scan(), a view into the DB which is only valid during the visitor call
+struct ScanEntry
+{
+	std::string_view key;
+	ValueType type {ValueType::UNDEFINED};
+	bool isModified {false}; // Comes from the Modified DB
+	const std::vector<std::any>* values {nullptr};
+
+	std::size_t size() const { return values ? values->size() : 0; }
+
+	// T is the integer type matching type, or std::string_view for CHAR entries (whose last value is the whole string)
+	template<typename T>
+	std::optional<T> getValue(std::size_t i) const
+	{
+		if(values == nullptr || i >= values->size()) return std::nullopt;
+
+		const T* value = std::any_cast<T>(&(*values)[i]);
+		return value ? std::optional<T>(*value) : std::nullopt;
+	}
+};
+
+// One key of IDatabase::getMany(): values points to the vector filled as by get() of the same type, rc is set per key
+struct GetRequest
+{
+	std::string key;
+	std::variant<std::vector<uint8_t>*, std::vector<int8_t>*, std::vector<uint16_t>*, std::vector<int16_t>*, std::vector<uint32_t>*,
+		std::vector<int32_t>*, std::vector<uint64_t>*, std::vector<int64_t>*, std::vector<std::string>*> values;
+	ReturnCodeEnum rc {ReturnCodeRaw::UNDEFINED};
+};
+
+// Kind of change delivered to the callbacks of IDatabase::subscribe()
+enum class ChangeKind
+{
+	UPDATED, // update(), setScalar(), compareAndUpdate() or fetchAdd()
+	ERASED,
+	RESTORED,
+	RESET // reset() reverted the key to its Original DB value
+};
+
+// One changed key. Changes of the same key which are still queued when the notification thread gets to them are coalesced
+// into one event with the kind of the latest change.
+struct ChangeEvent
+{
+	std::string key;
+	ChangeKind kind {ChangeKind::UPDATED};
+};
+
+using SubscriptionId = uint64_t;
+
+// Position of a key in the DB image it was generated from, along with the LoadStats::checksum of that image, see IDatabase::getById()
+struct EntryId
+{
+	uint32_t position {0};
+	uint64_t dbChecksum {0};
+};
+
+// Reads of one DB version, see IDatabase::snapshot(). Writes made after it was taken are not visible through it.
+class IDatabaseSnapshot
+{
+public:
+	virtual ~IDatabaseSnapshot() = default;
+
+	virtual uint64_t version() const = 0;
+
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint8_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<int8_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint16_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<int16_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint32_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<int32_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint64_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<int64_t>& values) const = 0;
+	virtual ReturnCodeEnum get(const std::string& key, std::vector<std::string>& values) const = 0;
+};
+
 class IDatabase
 {
 public:
@@ -74,6 +352,8 @@ public:
 	IDatabase& operator=(const IDatabase& other) = delete;
 	IDatabase& operator=(IDatabase&& other) = delete;
 
+	// A key which matches no entry, neither whole nor by its sub-keys, reads the entry of the longest whole key it continues by
+	// sub-keys: a board specific /hw/x/fanSpeed/board7 falls back to /hw/x/fanSpeed. All reads do so, update() and erase() never.
 	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint8_t>& values) const = 0;
 	virtual ReturnCodeEnum get(const std::string& key, std::vector<int8_t>& values) const = 0;
 	virtual ReturnCodeEnum get(const std::string& key, std::vector<uint16_t>& values) const = 0;
@@ -107,6 +387,156 @@ public:
 	// Mark a specific key as deleted
 	virtual ReturnCodeEnum erase(const std::string& key) const = 0;
 
+	// Read all requests from the same state of the DB, locking it once for the whole batch instead of once per key.
+	// Returns OK if every request succeeded, otherwise the rc of the first failed one.
+	virtual ReturnCodeEnum getMany(std::vector<GetRequest>& requests) const = 0;
+
+	// Visit the entries under prefix (the key itself and the keys continuing it with '/') in key order, stopping as soon as visitor
+	// returns false. Modified DB entries replace their Original DB ones, erased entries are skipped, type limits the visit to one type.
+	// No DB lock is held while visitor runs, so it may call back into IDatabase. Returns the number of visited entries.
+	virtual std::size_t scan(std::string_view prefix, const std::function<bool(const ScanEntry&)>& visitor,
+		std::optional<ValueType> type = std::nullopt) const = 0;
+
+	// Real-time read path: copies at most capacity values into the caller's buffer and sets count to the number of values of the entry,
+	// BUFFER_TOO_SMALL is returned if count > capacity. Nothing is allocated and no trace is formatted, misses are only reported by rc.
+	virtual ReturnCodeEnum get(std::string_view key, uint8_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, int8_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, uint16_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, int16_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, uint32_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, int32_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, uint64_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum get(std::string_view key, int64_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	// CHAR entries: copies the whole string NUL-terminated (truncated if it does not fit), length excludes the NUL
+	virtual ReturnCodeEnum get(std::string_view key, char* value, std::size_t capacity, std::size_t& length) const = 0;
+
+	template<typename T, std::size_t N>
+	ReturnCodeEnum get(std::string_view key, T (&values)[N], std::size_t& count) const
+	{
+		return get(key, values, N, count);
+	}
+
+	// Single-value entries: an exact key of up to 32 bits is read with one atomic load and, once it was written before, soft-written
+	// with one compare-and-swap, both without lock. Partial keys, 64-bit entries, the first write of a key and hard writes take
+	// the regular get()/update() path. Entries which do not have exactly one value return TYPE_MISMATCH on read.
+	virtual ReturnCodeEnum getScalar(std::string_view key, uint8_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, int8_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, uint16_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, int16_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, uint32_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, int32_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, uint64_t& value) const = 0;
+	virtual ReturnCodeEnum getScalar(std::string_view key, int64_t& value) const = 0;
+	// Reads by entry id, which the accessors generated by textToBin -g are bound to: no key lookup and, for an entry which was never
+	// changed, no lock either. Positions are only meaningful for the DB image they were generated from, so an id whose dbChecksum
+	// is not the LoadStats::checksum of the loaded DB returns DB_MISMATCH and a position beyond it KEY_NOT_FOUND.
+	// Same results as get(key, values, capacity, count) and getScalar() otherwise.
+	virtual ReturnCodeEnum getById(EntryId id, uint8_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, int8_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, uint16_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, int16_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, uint32_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, int32_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, uint64_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, int64_t* values, std::size_t capacity, std::size_t& count) const = 0;
+	virtual ReturnCodeEnum getById(EntryId id, char* value, std::size_t capacity, std::size_t& length) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, uint8_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, int8_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, uint16_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, int16_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, uint32_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, int32_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, uint64_t& value) const = 0;
+	virtual ReturnCodeEnum getScalarById(EntryId id, int64_t& value) const = 0;
+
+	virtual ReturnCodeEnum setScalar(std::string_view key, uint8_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, int8_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, uint16_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, int16_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, uint32_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, int32_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, uint64_t value, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum setScalar(std::string_view key, int64_t value, bool isHardWrite = false) const = 0;
+
+	// Atomic read-modify-write of a single-value entry, one lookup and at most one lock: none for a soft write of an exact key of up
+	// to 32 bits which was written before. compareAndUpdate() writes desired only if the entry holds expected, otherwise it returns
+	// VALUE_MISMATCH and sets expected to the current value. fetchAdd() adds delta (wrapping around on overflow) and returns the
+	// value before in previousValue. Entries which do not have exactly one value return TYPE_MISMATCH.
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, uint8_t& expected, uint8_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, int8_t& expected, int8_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, uint16_t& expected, uint16_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, int16_t& expected, int16_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, uint32_t& expected, uint32_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, int32_t& expected, int32_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, uint64_t& expected, uint64_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum compareAndUpdate(std::string_view key, int64_t& expected, int64_t desired, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, uint8_t delta, uint8_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, int8_t delta, int8_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, uint16_t delta, uint16_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, int16_t delta, int16_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, uint32_t delta, uint32_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, int32_t delta, int32_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, uint64_t delta, uint64_t& previousValue, bool isHardWrite = false) const = 0;
+	virtual ReturnCodeEnum fetchAdd(std::string_view key, int64_t delta, int64_t& previousValue, bool isHardWrite = false) const = 0;
+
+	// Call callback on the notification thread for every change of an entry under keyOrPrefix (matched as by scan()), or with all
+	// changes under keyOrPrefix since its last call for subscribeBatch(). Writers only push the change onto a lock-free queue and
+	// never wait for a subscriber, a slow callback just delays the next deliveries (and coalesces more changes into them).
+	// Writes allocate one queue node each while there is at least one subscription, and nothing otherwise.
+	virtual SubscriptionId subscribe(std::string_view keyOrPrefix, std::function<void(const ChangeEvent&)> callback) const = 0;
+	virtual SubscriptionId subscribeBatch(std::string_view keyOrPrefix, std::function<void(const std::vector<ChangeEvent>&)> callback) const = 0;
+	// Once it returns the callback is not called anymore and no call of it is running, unless it is called from a callback itself
+	virtual bool unsubscribe(SubscriptionId id) const = 0;
+
+	// The DB version starts at 0 and every write, erase(), restore() and reset() increments it by one.
+	// A snapshot pins the current version for any number of get() calls: it copies the Modified DB (the Original DB is never
+	// written in place), so taking one costs about as much as the number of modified entries, and reading from it as a get().
+	virtual uint64_t version() const = 0;
+	virtual std::unique_ptr<IDatabaseSnapshot> snapshot() const = 0;
+
+	// Every entry is stamped with the version of its last change (0 if never changed). getIfChanged() sets entryVersion to it and
+	// returns UNCHANGED without copying the values if it is not newer than sinceVersion, so a cache can pass the entryVersion
+	// of its copy. A key erased after sinceVersion returns KEY_NOT_FOUND.
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint8_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int8_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint16_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int16_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint32_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int32_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint64_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int64_t>& values, uint64_t& entryVersion) const = 0;
+	virtual ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<std::string>& values, uint64_t& entryVersion) const = 0;
+
+	// Real-time mode: loads the DB if not done yet and locks all current and future pages of the process in RAM (mlockall),
+	// so that the get() above never page-faults. Requires CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK.
+	virtual bool lockMemory() const = 0;
+
+	// Statistics are off by default (or on if the environment variable DBENGINE_STATS=1 is set), they cost a few ns per call when on
+	virtual void enableStats(bool isEnabled) const = 0;
+
+	// Off by default. With a capacity every thread keeps up to capacity (rounded up to a power of two) results of the
+	// get(key, std::vector<T>&) overloads, so repeated reads of hot keys skip the lookup and the locks. Any write, erase(),
+	// restore() or reset() invalidates all of them at once. Each thread allocates its cache on its first get() after this call.
+	virtual void enableReadCache(std::size_t capacity) const = 0;
+	virtual DatabaseStats stats() const = 0;
+
+	// Trace points below level are skipped before their message is formatted. Levels compiled out (DBENGINE_TRACE_MIN_LEVEL) cannot be enabled.
+	virtual void setTraceLevel(TraceLevel level) const = 0;
+
+	// Breakdown of the startup load, it never changes after the first DB access
+	virtual LoadStats loadStats() const = 0;
+
+	// Walks all entries once, prefixDepth is the number of sub-keys grouped in perPrefix, e.g. 1 gives /hw and /sw
+	virtual MemoryUsage memoryUsage(uint32_t prefixDepth = 1) const = 0;
+
+	// Sample every samplingPeriod-th get()/update() of each thread into bounded heavy-hitter sketches of capacity keys each,
+	// samplingPeriod 0 turns tracking off (the default) and clears the sketches. Unsampled calls cost one thread-local countdown.
+	virtual void enableHotKeyTracking(uint32_t samplingPeriod, std::size_t capacity = 256) const = 0;
+	virtual HotKeyReport hotKeys(std::size_t topK) const = 0;
+
+	// Write the topK most read and written keys, one per line with their counts, as a warm-up manifest for the next boot
+	virtual bool exportHotKeys(const std::string& filePath, std::size_t topK) const = 0;
+
 	template<typename T>
 	std::optional<std::vector<T>> autoGetVec(const std::string& key) noexcept
 	{
@@ -151,6 +581,26 @@ public:
 		return std::nullopt;
 	}
 
+	// Bodies of the generated accessors of single-value and N-value entries, std::nullopt unless the entry has exactly that many values
+	template<typename T>
+	std::optional<T> autoGetById(EntryId id) const noexcept
+	{
+		T value {};
+		if(getScalarById(id, value).getRawEnum() != ReturnCodeRaw::OK) return std::nullopt;
+
+		return value;
+	}
+
+	template<typename T, std::size_t N>
+	std::optional<std::array<T, N>> autoGetArrayById(EntryId id) const noexcept
+	{
+		std::array<T, N> values {};
+		std::size_t count = 0;
+		if(getById(id, values.data(), N, count).getRawEnum() != ReturnCodeRaw::OK || count != N) return std::nullopt;
+
+		return values;
+	}
+
 protected:
 	IDatabase() = default;
 	virtual ~IDatabase() = default;
@@ -59,6 +59,99 @@ public:
 
 	ReturnCodeEnum erase(const std::string& key) const override;
 
+	ReturnCodeEnum getMany(std::vector<GetRequest>& requests) const override;
+	std::size_t scan(std::string_view prefix, const std::function<bool(const ScanEntry&)>& visitor,
+		std::optional<ValueType> type = std::nullopt) const override;
+
+	ReturnCodeEnum get(std::string_view key, uint8_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, int8_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, uint16_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, int16_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, uint32_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, int32_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, uint64_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, int64_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum get(std::string_view key, char* value, std::size_t capacity, std::size_t& length) const override;
+
+	ReturnCodeEnum getScalar(std::string_view key, uint8_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, int8_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, uint16_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, int16_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, uint32_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, int32_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, uint64_t& value) const override;
+	ReturnCodeEnum getScalar(std::string_view key, int64_t& value) const override;
+	ReturnCodeEnum getById(EntryId id, uint8_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, int8_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, uint16_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, int16_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, uint32_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, int32_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, uint64_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, int64_t* values, std::size_t capacity, std::size_t& count) const override;
+	ReturnCodeEnum getById(EntryId id, char* value, std::size_t capacity, std::size_t& length) const override;
+	ReturnCodeEnum getScalarById(EntryId id, uint8_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, int8_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, uint16_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, int16_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, uint32_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, int32_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, uint64_t& value) const override;
+	ReturnCodeEnum getScalarById(EntryId id, int64_t& value) const override;
+	ReturnCodeEnum setScalar(std::string_view key, uint8_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, int8_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, uint16_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, int16_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, uint32_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, int32_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, uint64_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum setScalar(std::string_view key, int64_t value, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, uint8_t& expected, uint8_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, int8_t& expected, int8_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, uint16_t& expected, uint16_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, int16_t& expected, int16_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, uint32_t& expected, uint32_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, int32_t& expected, int32_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, uint64_t& expected, uint64_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum compareAndUpdate(std::string_view key, int64_t& expected, int64_t desired, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, uint8_t delta, uint8_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, int8_t delta, int8_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, uint16_t delta, uint16_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, int16_t delta, int16_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, uint32_t delta, uint32_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, int32_t delta, int32_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, uint64_t delta, uint64_t& previousValue, bool isHardWrite = false) const override;
+	ReturnCodeEnum fetchAdd(std::string_view key, int64_t delta, int64_t& previousValue, bool isHardWrite = false) const override;
+
+	SubscriptionId subscribe(std::string_view keyOrPrefix, std::function<void(const ChangeEvent&)> callback) const override;
+	SubscriptionId subscribeBatch(std::string_view keyOrPrefix, std::function<void(const std::vector<ChangeEvent>&)> callback) const override;
+	bool unsubscribe(SubscriptionId id) const override;
+
+	uint64_t version() const override;
+	std::unique_ptr<IDatabaseSnapshot> snapshot() const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint8_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int8_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint16_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int16_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint32_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int32_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint64_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int64_t>& values, uint64_t& entryVersion) const override;
+	ReturnCodeEnum getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<std::string>& values, uint64_t& entryVersion) const override;
+
+	bool lockMemory() const override;
+
+	void enableStats(bool isEnabled) const override;
+	void enableReadCache(std::size_t capacity) const override;
+	DatabaseStats stats() const override;
+	void setTraceLevel(TraceLevel level) const override;
+	LoadStats loadStats() const override;
+	MemoryUsage memoryUsage(uint32_t prefixDepth = 1) const override;
+
+	void enableHotKeyTracking(uint32_t samplingPeriod, std::size_t capacity = 256) const override;
+	HotKeyReport hotKeys(std::size_t topK) const override;
+	bool exportHotKeys(const std::string& filePath, std::size_t topK) const override;
+
 
 private:
 	DatabaseImpl() = default;
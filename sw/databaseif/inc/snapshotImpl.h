@@ -0,0 +1,58 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "databaseIf.h"
+#include "dbLoader.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+class SnapshotImpl : public IDatabaseSnapshot
+{
+public:
+	explicit SnapshotImpl(std::shared_ptr<const DbLoader::Snapshot> snapshot) : m_snapshot(std::move(snapshot)) {}
+	~SnapshotImpl() override = default;
+
+	SnapshotImpl(const SnapshotImpl& other) = delete;
+	SnapshotImpl(SnapshotImpl&& other) = delete;
+	SnapshotImpl& operator=(const SnapshotImpl& other) = delete;
+	SnapshotImpl& operator=(SnapshotImpl&& other) = delete;
+
+	uint64_t version() const override;
+
+	ReturnCodeEnum get(const std::string& key, std::vector<uint8_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<int8_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<uint16_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<int16_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<uint32_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<int32_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<uint64_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<int64_t>& values) const override;
+	ReturnCodeEnum get(const std::string& key, std::vector<std::string>& values) const override;
+
+private:
+	std::shared_ptr<const DbLoader::Snapshot> m_snapshot;
+
+}; // class SnapshotImpl
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "databaseImpl.h"
+#include "snapshotImpl.h"
 
 namespace DbEngine
 {
@@ -146,6 +147,426 @@ ReturnCodeEnum DatabaseImpl::erase(const std::string& key) const
 	return DbLoader::getInstance().erase(key);
 }
 
+ReturnCodeEnum DatabaseImpl::getMany(std::vector<GetRequest>& requests) const
+{
+	return DbLoader::getInstance().retrieveMany(requests);
+}
+
+std::size_t DatabaseImpl::scan(std::string_view prefix, const std::function<bool(const ScanEntry&)>& visitor, std::optional<ValueType> type) const
+{
+	return DbLoader::getInstance().scan(prefix, visitor, type);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, uint8_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<uint8_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, int8_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<int8_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, uint16_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<uint16_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, int16_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<int16_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, uint32_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<uint32_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, int32_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<int32_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, uint64_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<uint64_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, int64_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveInto<int64_t>(key, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::get(std::string_view key, char* value, std::size_t capacity, std::size_t& length) const
+{
+	return DbLoader::getInstance().retrieveInto<char>(key, value, capacity, length);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, uint8_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<uint8_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, int8_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<int8_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, uint16_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<uint16_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, int16_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<int16_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, uint32_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<uint32_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, int32_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<int32_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, uint64_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<uint64_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalar(std::string_view key, int64_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalar<int64_t>(key, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, uint8_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<uint8_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, int8_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<int8_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, uint16_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<uint16_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, int16_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<int16_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, uint32_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<uint32_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, int32_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<int32_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, uint64_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<uint64_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, int64_t* values, std::size_t capacity, std::size_t& count) const
+{
+	return DbLoader::getInstance().retrieveIntoById<int64_t>(id, values, capacity, count);
+}
+
+ReturnCodeEnum DatabaseImpl::getById(EntryId id, char* value, std::size_t capacity, std::size_t& length) const
+{
+	return DbLoader::getInstance().retrieveIntoById<char>(id, value, capacity, length);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, uint8_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<uint8_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, int8_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<int8_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, uint16_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<uint16_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, int16_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<int16_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, uint32_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<uint32_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, int32_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<int32_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, uint64_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<uint64_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::getScalarById(EntryId id, int64_t& value) const
+{
+	return DbLoader::getInstance().retrieveScalarById<int64_t>(id, value);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, uint8_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<uint8_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, int8_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<int8_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, uint16_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<uint16_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, int16_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<int16_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, uint32_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<uint32_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, int32_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<int32_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, uint64_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<uint64_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::setScalar(std::string_view key, int64_t value, bool isHardWrite) const
+{
+	return DbLoader::getInstance().updateScalar<int64_t>(key, value, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, uint8_t& expected, uint8_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<uint8_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, int8_t& expected, int8_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<int8_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, uint16_t& expected, uint16_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<uint16_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, int16_t& expected, int16_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<int16_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, uint32_t& expected, uint32_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<uint32_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, int32_t& expected, int32_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<int32_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, uint64_t& expected, uint64_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<uint64_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::compareAndUpdate(std::string_view key, int64_t& expected, int64_t desired, bool isHardWrite) const
+{
+	return DbLoader::getInstance().compareAndUpdate<int64_t>(key, expected, desired, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, uint8_t delta, uint8_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<uint8_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, int8_t delta, int8_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<int8_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, uint16_t delta, uint16_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<uint16_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, int16_t delta, int16_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<int16_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, uint32_t delta, uint32_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<uint32_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, int32_t delta, int32_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<int32_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, uint64_t delta, uint64_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<uint64_t>(key, delta, previousValue, isHardWrite);
+}
+
+ReturnCodeEnum DatabaseImpl::fetchAdd(std::string_view key, int64_t delta, int64_t& previousValue, bool isHardWrite) const
+{
+	return DbLoader::getInstance().fetchAdd<int64_t>(key, delta, previousValue, isHardWrite);
+}
+
+SubscriptionId DatabaseImpl::subscribe(std::string_view keyOrPrefix, std::function<void(const ChangeEvent&)> callback) const
+{
+	return DbLoader::getInstance().subscribe(keyOrPrefix, std::move(callback), nullptr);
+}
+
+SubscriptionId DatabaseImpl::subscribeBatch(std::string_view keyOrPrefix, std::function<void(const std::vector<ChangeEvent>&)> callback) const
+{
+	return DbLoader::getInstance().subscribe(keyOrPrefix, nullptr, std::move(callback));
+}
+
+bool DatabaseImpl::unsubscribe(SubscriptionId id) const
+{
+	return DbLoader::getInstance().unsubscribe(id);
+}
+
+uint64_t DatabaseImpl::version() const
+{
+	return DbLoader::getInstance().getVersion();
+}
+
+std::unique_ptr<IDatabaseSnapshot> DatabaseImpl::snapshot() const
+{
+	return std::make_unique<SnapshotImpl>(DbLoader::getInstance().takeSnapshot());
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint8_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<uint8_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int8_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<int8_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint16_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<uint16_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int16_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<int16_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint32_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<uint32_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int32_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<int32_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<uint64_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<uint64_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<int64_t>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<int64_t>(key, sinceVersion, values, entryVersion);
+}
+
+ReturnCodeEnum DatabaseImpl::getIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<std::string>& values, uint64_t& entryVersion) const
+{
+	return DbLoader::getInstance().retrieveIfChanged<std::string>(key, sinceVersion, values, entryVersion);
+}
+
+bool DatabaseImpl::lockMemory() const
+{
+	return DbLoader::getInstance().lockMemory();
+}
+
+void DatabaseImpl::enableStats(bool isEnabled) const
+{
+	DbLoader::getInstance().enableStats(isEnabled);
+}
+
+void DatabaseImpl::enableReadCache(std::size_t capacity) const
+{
+	DbLoader::getInstance().enableReadCache(capacity);
+}
+
+DatabaseStats DatabaseImpl::stats() const
+{
+	return DbLoader::getInstance().getStats();
+}
+
+void DatabaseImpl::setTraceLevel(TraceLevel level) const
+{
+	DbTrace::setLevel(level);
+}
+
+LoadStats DatabaseImpl::loadStats() const
+{
+	return DbLoader::getInstance().getLoadStats();
+}
+
+MemoryUsage DatabaseImpl::memoryUsage(uint32_t prefixDepth) const
+{
+	return DbLoader::getInstance().getMemoryUsage(prefixDepth);
+}
+
+void DatabaseImpl::enableHotKeyTracking(uint32_t samplingPeriod, std::size_t capacity) const
+{
+	DbLoader::getInstance().enableHotKeyTracking(samplingPeriod, capacity);
+}
+
+HotKeyReport DatabaseImpl::hotKeys(std::size_t topK) const
+{
+	return DbLoader::getInstance().getHotKeys(topK);
+}
+
+bool DatabaseImpl::exportHotKeys(const std::string& filePath, std::size_t topK) const
+{
+	return DbLoader::getInstance().exportHotKeys(filePath, topK);
+}
+
 } // namespace V1
 
 } // namespace DatabaseIf
@@ -0,0 +1,67 @@
+#include <vector>
+#include <string>
+
+#include "snapshotImpl.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+uint64_t SnapshotImpl::version() const
+{
+	return m_snapshot->version;
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<uint8_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<uint8_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<int8_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<int8_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<uint16_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<uint16_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<int16_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<int16_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<uint32_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<uint32_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<int32_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<int32_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<uint64_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<uint64_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<int64_t>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<int64_t>(*m_snapshot, key, values);
+}
+
+ReturnCodeEnum SnapshotImpl::get(const std::string& key, std::vector<std::string>& values) const
+{
+	return DbLoader::getInstance().retrieveFromSnapshot<std::string>(*m_snapshot, key, values);
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,668 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "databaseIf.h"
+
+using namespace DbEngine::DatabaseIf::V1;
+
+enum class Operation
+{
+	GET,
+	UPDATE,
+	HARD_UPDATE,
+	ERASE,
+	RESTORE,
+	RESET,
+	NUMBER_OF_OPERATIONS
+};
+
+constexpr std::size_t NUMBER_OF_OPERATIONS = static_cast<std::size_t>(Operation::NUMBER_OF_OPERATIONS);
+const std::array<const char*, NUMBER_OF_OPERATIONS> OPERATION_NAMES = {"get", "update", "hard", "erase", "restore", "reset"};
+
+struct StressConfig
+{
+	uint32_t numberOfEntries {10000};
+	uint32_t keyDepth {5};
+	uint32_t arrayLength {4};
+	uint32_t maxThreads {4};
+	uint32_t durationMs {1000};
+	std::array<uint32_t, NUMBER_OF_OPERATIONS> weights {800, 150, 1, 20, 28, 1}; // Per mille of the operations of every thread
+	uint64_t seed {1};
+	std::string workDir {"/tmp/dbengine-stress"};
+	std::string textToBinPath {""};
+	std::string textDbGeneratorPath {""};
+	std::string outputFormat {"text"};
+};
+
+// Every value of an entry encodes it: the first one is a tag of its id, all others hold the same generation, which every
+// update changes at once. A read mixing two generations is torn, a read with the tag of another entry went through a corrupted index.
+struct StressEntry
+{
+	std::string key;
+	std::string type;
+	uint32_t id {0};
+	bool isWritable {true};
+	bool isErasable {false}; // Only these are erased, every other entry must always be found
+	uint64_t originalGeneration {0};
+};
+
+struct OperationResult
+{
+	uint64_t ops {0};
+	uint64_t unexpectedRcs {0}; // Return codes which the DB state can never explain, counted as violations too
+	LatencyHistogram latency;
+};
+
+struct StepResult
+{
+	uint32_t threads {1};
+	double elapsedNs {0};
+	std::array<OperationResult, NUMBER_OF_OPERATIONS> operations;
+	OperationResult all;
+	uint64_t violations {0};
+	uint64_t contendedLocks {0};
+	uint64_t uncontendedLocks {0};
+	LatencyHistogram lockWait;
+};
+
+using Clock = std::chrono::steady_clock;
+
+/* Format: ./databaseIfStress -b <path_to_textToBin> -g <path_to_textDbGenerator> [options]		*/
+/* Runs the same operation mix with 1, 2, 4, ... up to -t threads for -D ms each and checks every read		*/
+/* Options:												*/
+/* 	+ b: path to the textToBin executable used to compile the synthetic database			*/
+/* 	+ g: path to the textDbGenerator executable used to generate the synthetic database		*/
+/* 	+ n: number of entries of the synthetic database (default 10000)				*/
+/* 	+ d: maximum number of sub-keys per key, at least 3 (default 5)					*/
+/* 	+ a: number of values per entry, at least 2 (default 4)						*/
+/* 	+ t: maximum number of threads (default 4)							*/
+/* 	+ D: duration of every thread count in milliseconds (default 1000)				*/
+/* 	+ x: operation mix in per mille, e.g. get=900,update=100 (default get=800,update=150,hard=1,	*/
+/* 	     erase=20,restore=28,reset=1), operations left out are not run				*/
+/* 	+ s: seed of the synthetic database and of the access pattern (default 1)			*/
+/* 	+ w: working directory of the synthetic database (default /tmp/dbengine-stress)			*/
+/* 	+ f: output format text, csv or json (default text)						*/
+/* Exits with EXIT_FAILURE if any check failed, so it can gate a release				*/
+void printUsage(const char* program);
+bool parseMix(const std::string& mix, StressConfig& cfg);
+std::vector<StressEntry> generateTextDb(const StressConfig& cfg, const std::string& txtFilePath);
+std::string formatValue(const StressEntry& e, uint64_t generation, uint32_t arrayLength);
+StepResult runStep(uint32_t threads, const StressConfig& cfg, const std::vector<StressEntry>& entries, const std::vector<const StressEntry*>& erasableEntries);
+bool getAndCheck(const StressEntry& e, uint32_t arrayLength, bool& isConsistent);
+ReturnCodeEnum updateByType(const StressEntry& e, uint64_t generation, uint32_t arrayLength, bool isHardWrite);
+uint64_t verifyOriginalDb(const std::vector<StressEntry>& entries, uint32_t arrayLength);
+void reportViolation(const std::string& message);
+void merge(LatencyHistogram& into, const LatencyHistogram& from);
+LatencyHistogram subtract(const LatencyHistogram& after, const LatencyHistogram& before);
+void printResults(const std::vector<StepResult>& results, const StressConfig& cfg, uint64_t finalViolations);
+
+int main(int argc, char* argv[])
+{
+	StressConfig cfg;
+	int opt = 0;
+
+	while((opt = getopt(argc, argv, "b:g:n:d:a:t:D:x:s:w:f:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'b':
+			cfg.textToBinPath = std::string(optarg);
+			break;
+		case 'g':
+			cfg.textDbGeneratorPath = std::string(optarg);
+			break;
+		case 'n':
+			cfg.numberOfEntries = std::stoul(optarg);
+			break;
+		case 'd':
+			cfg.keyDepth = std::max(3ul, std::stoul(optarg));
+			break;
+		case 'a':
+			cfg.arrayLength = std::max(2ul, std::stoul(optarg));
+			break;
+		case 't':
+			cfg.maxThreads = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'D':
+			cfg.durationMs = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'x':
+			if(!parseMix(optarg, cfg))
+			{
+				printUsage(argv[0]);
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 's':
+			cfg.seed = std::stoull(optarg);
+			break;
+		case 'w':
+			cfg.workDir = std::string(optarg);
+			break;
+		case 'f':
+			cfg.outputFormat = std::string(optarg);
+			break;
+		default:
+			printUsage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if(cfg.textToBinPath.empty() || cfg.textDbGeneratorPath.empty() || cfg.numberOfEntries < 8)
+	{
+		printUsage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	// Compile the synthetic database and point DbLoader at it, must happen before the first DB access
+	mkdir(cfg.workDir.c_str(), 0755);
+	const std::string txtFilePath = cfg.workDir + "/swdb.txt";
+	const std::string binFilePath = cfg.workDir + "/swdb.bin";
+	std::remove(std::string(cfg.workDir + "/swdb-hardsave.bin").c_str());
+
+	const std::vector<StressEntry> entries = generateTextDb(cfg, txtFilePath);
+	const std::string command = cfg.textToBinPath + " -i " + txtFilePath + " -o " + binFilePath + " > /dev/null";
+	if(std::system(command.c_str()) != 0)
+	{
+		std::cout << "ERROR: Failed to compile the synthetic database: " << command << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	setenv("DBENGINE_SWDB_DIR", cfg.workDir.c_str(), 1);
+	setenv("DBENGINE_TRACE_LEVEL", "error", 0); // Misses of erased keys are expected, do not trace each of them
+
+	std::vector<const StressEntry*> erasableEntries;
+	for(const auto& e : entries)
+	{
+		if(e.isErasable) erasableEntries.push_back(&e);
+	}
+
+	// The original DB must pass the checks before anything is written
+	uint64_t finalViolations = verifyOriginalDb(entries, cfg.arrayLength);
+
+	// Lock waits are only collected with statistics on, which all thread counts pay for alike
+	IDatabase::getInstance().enableStats(true);
+
+	std::vector<StepResult> results;
+	for(uint32_t threads = 1; ; threads = std::min(threads * 2, cfg.maxThreads))
+	{
+		results.push_back(runStep(threads, cfg, entries, erasableEntries));
+		if(threads == cfg.maxThreads) break;
+	}
+
+	// Nothing may be left of the writes once the Modified DB is reset
+	(void)IDatabase::getInstance().reset();
+	finalViolations += verifyOriginalDb(entries, cfg.arrayLength);
+
+	printResults(results, cfg, finalViolations);
+
+	uint64_t violations = finalViolations;
+	for(const auto& r : results) violations += r.violations;
+	exit(violations ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+void printUsage(const char* program)
+{
+	std::cout << "ERROR:\n";
+	std::cout << "\tUsage:  " << program << " -b <path_to_textToBin> -g <path_to_textDbGenerator> [-n entries] [-d depth] [-a values] [-t threads] [-D ms] [-x mix] [-s seed] [-w dir] [-f text|csv|json]\n";
+	std::cout << "\tOption:\n";
+	std::cout << "\t\t -b : path to the textToBin executable.\n";
+	std::cout << "\t\t -g : path to the textDbGenerator executable.\n";
+	std::cout << "\t\t -n : number of entries of the synthetic database, at least 8.\n";
+	std::cout << "\t\t -d : maximum number of sub-keys per key, at least 3.\n";
+	std::cout << "\t\t -a : number of values per entry, at least 2.\n";
+	std::cout << "\t\t -t : maximum number of threads, runs 1, 2, 4, ... up to it.\n";
+	std::cout << "\t\t -D : duration of every thread count in milliseconds.\n";
+	std::cout << "\t\t -x : operation mix in per mille of get, update, hard, erase, restore and reset, e.g. get=900,update=100.\n";
+	std::cout << "\t\t -s : seed of the synthetic database and access pattern.\n";
+	std::cout << "\t\t -w : working directory of the synthetic database.\n";
+	std::cout << "\t\t -f : output format, text, csv or json.\n";
+}
+
+bool parseMix(const std::string& mix, StressConfig& cfg)
+{
+	cfg.weights.fill(0);
+
+	std::stringstream ss(mix);
+	std::string item;
+	uint32_t total = 0;
+	while(std::getline(ss, item, ','))
+	{
+		const auto separator = item.find('=');
+		if(separator == std::string::npos) return false;
+
+		const std::string name = item.substr(0, separator);
+		const auto it = std::find(OPERATION_NAMES.begin(), OPERATION_NAMES.end(), name);
+		if(it == OPERATION_NAMES.end()) return false;
+
+		const uint32_t weight = std::stoul(item.substr(separator + 1));
+		cfg.weights[it - OPERATION_NAMES.begin()] = weight;
+		total += weight;
+	}
+
+	return total > 0;
+}
+
+// Tags and generations stay within the positive range of the smallest type of their size, the same as textDbGenerator -t
+uint64_t getValueRange(const std::string& type)
+{
+	if(type == "U8" || type == "S8") return 100;
+	else if(type == "U16" || type == "S16") return 30000;
+	return 1000000000;
+}
+
+std::vector<StressEntry> generateTextDb(const StressConfig& cfg, const std::string& txtFilePath)
+{
+	// Tagged values encode their entry as the checks expect, wildcard keys are left out as every entry is addressed exactly
+	const std::string command = cfg.textDbGeneratorPath + " -o " + txtFilePath + " -n " + std::to_string(cfg.numberOfEntries) + " -d "
+		+ std::to_string(cfg.keyDepth) + " -a " + std::to_string(cfg.arrayLength) + " -w 0 -t -s " + std::to_string(cfg.seed) + " > /dev/null";
+	if(std::system(command.c_str()) != 0)
+	{
+		std::cout << "ERROR: Failed to generate the synthetic database: " << command << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	std::ifstream txtFile(txtFilePath);
+	if(!txtFile.is_open())
+	{
+		std::cout << "ERROR: Failed to open file: " << txtFilePath << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	std::vector<StressEntry> entries;
+	entries.reserve(cfg.numberOfEntries);
+
+	// Every line which is neither empty nor a comment is <key> <permission> <type> <tag>, <generation>, ...
+	std::string line;
+	while(std::getline(txtFile, line))
+	{
+		if(line.empty() || line.rfind("/*", 0) == 0) continue;
+
+		StressEntry e;
+		std::string permission;
+		std::string tag;
+		std::string generation;
+		std::istringstream(line) >> e.key >> permission >> e.type >> tag >> generation;
+		e.id = entries.size();
+		e.isWritable = permission == "RW";
+		e.isErasable = e.isWritable && (e.id % 4) == 0;
+		e.originalGeneration = std::stoull(e.type == "CHAR" ? generation.substr(1) : generation); // Drop the g of a CHAR generation
+		entries.push_back(std::move(e));
+	}
+
+	return entries;
+}
+
+std::string formatValue(const StressEntry& e, uint64_t generation, uint32_t arrayLength)
+{
+	if(e.type == "CHAR")
+	{
+		std::string value = "\"k" + std::to_string(e.id);
+		for(uint32_t i = 1; i < arrayLength; ++i) value += " g" + std::to_string(generation);
+		return value + "\"";
+	}
+
+	std::string value = std::to_string(e.id % getValueRange(e.type));
+	for(uint32_t i = 1; i < arrayLength; ++i) value += ", " + std::to_string(generation);
+	return value;
+}
+
+void reportViolation(const std::string& message)
+{
+	// Only the first few are printed, a broken build would flood the output otherwise
+	static std::mutex mtx;
+	static uint32_t numberOfReported = 0;
+	std::scoped_lock<std::mutex> lock(mtx);
+	if(numberOfReported++ < 10) std::cout << "VIOLATION: " << message << std::endl;
+}
+
+template<typename T>
+bool checkValues(const StressEntry& e, const std::vector<T>& values, uint32_t arrayLength)
+{
+	if constexpr(std::is_same<T, std::string>::value)
+	{
+		// Every token, then the complete string
+		if(values.size() != arrayLength + 1 || values[0] != "k" + std::to_string(e.id)) return false;
+
+		std::string concatStr = values[0];
+		for(uint32_t i = 1; i < arrayLength; ++i)
+		{
+			if(values[i] != values[1]) return false;
+			concatStr += " " + values[i];
+		}
+		return values.back() == concatStr;
+	}
+	else
+	{
+		if(values.size() != arrayLength || values[0] != static_cast<T>(e.id % getValueRange(e.type))) return false;
+		return std::all_of(values.begin() + 1, values.end(), [&values](const T& v){ return v == values[1]; });
+	}
+}
+
+template<typename T>
+bool getAndCheckTyped(const StressEntry& e, uint32_t arrayLength, bool& isConsistent)
+{
+	std::vector<T> values;
+	const ReturnCodeEnum rc = IDatabase::getInstance().get(e.key, values);
+	isConsistent = rc.getRawEnum() != ReturnCodeRaw::OK || checkValues(e, values, arrayLength);
+	if(!isConsistent)
+	{
+		std::stringstream ss;
+		ss << "torn or foreign values of " << e.key << ":";
+		for(const auto& v : values)
+		{
+			if constexpr(std::is_same<T, std::string>::value) ss << " \"" << v << "\"";
+			else ss << " " << +v;
+		}
+		reportViolation(ss.str());
+	}
+
+	// Only erasable entries may be missing, the requested type is always the right one
+	return rc.getRawEnum() == ReturnCodeRaw::OK || (rc.getRawEnum() == ReturnCodeRaw::KEY_NOT_FOUND && e.isErasable);
+}
+
+bool getAndCheck(const StressEntry& e, uint32_t arrayLength, bool& isConsistent)
+{
+	if(e.type == "U8") return getAndCheckTyped<uint8_t>(e, arrayLength, isConsistent);
+	else if(e.type == "S8") return getAndCheckTyped<int8_t>(e, arrayLength, isConsistent);
+	else if(e.type == "U16") return getAndCheckTyped<uint16_t>(e, arrayLength, isConsistent);
+	else if(e.type == "S16") return getAndCheckTyped<int16_t>(e, arrayLength, isConsistent);
+	else if(e.type == "U32") return getAndCheckTyped<uint32_t>(e, arrayLength, isConsistent);
+	else if(e.type == "S32") return getAndCheckTyped<int32_t>(e, arrayLength, isConsistent);
+	else if(e.type == "U64") return getAndCheckTyped<uint64_t>(e, arrayLength, isConsistent);
+	else if(e.type == "S64") return getAndCheckTyped<int64_t>(e, arrayLength, isConsistent);
+	return getAndCheckTyped<std::string>(e, arrayLength, isConsistent);
+}
+
+template<typename T>
+ReturnCodeEnum updateTyped(const StressEntry& e, uint64_t generation, uint32_t arrayLength, bool isHardWrite)
+{
+	std::vector<T> values;
+	if constexpr(std::is_same<T, std::string>::value)
+	{
+		values.push_back("k" + std::to_string(e.id));
+		values.resize(arrayLength, "g" + std::to_string(generation));
+	}
+	else
+	{
+		values.push_back(static_cast<T>(e.id % getValueRange(e.type)));
+		values.resize(arrayLength, static_cast<T>(generation));
+	}
+	return IDatabase::getInstance().update(e.key, values, isHardWrite);
+}
+
+ReturnCodeEnum updateByType(const StressEntry& e, uint64_t generation, uint32_t arrayLength, bool isHardWrite)
+{
+	if(e.type == "U8") return updateTyped<uint8_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "S8") return updateTyped<int8_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "U16") return updateTyped<uint16_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "S16") return updateTyped<int16_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "U32") return updateTyped<uint32_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "S32") return updateTyped<int32_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "U64") return updateTyped<uint64_t>(e, generation, arrayLength, isHardWrite);
+	else if(e.type == "S64") return updateTyped<int64_t>(e, generation, arrayLength, isHardWrite);
+	return updateTyped<std::string>(e, generation, arrayLength, isHardWrite);
+}
+
+StepResult runStep(uint32_t threads, const StressConfig& cfg, const std::vector<StressEntry>& entries, const std::vector<const StressEntry*>& erasableEntries)
+{
+	std::array<uint32_t, NUMBER_OF_OPERATIONS> thresholds {};
+	uint32_t totalWeight = 0;
+	for(std::size_t op = 0; op < NUMBER_OF_OPERATIONS; ++op)
+	{
+		totalWeight += cfg.weights[op];
+		thresholds[op] = totalWeight;
+	}
+
+	StepResult step;
+	step.threads = threads;
+	std::mutex resultMutex;
+	std::atomic<uint64_t> violations {0};
+	const auto duration = std::chrono::milliseconds(cfg.durationMs);
+
+	auto worker = [&](uint32_t t){
+		std::mt19937_64 rng(cfg.seed * 1000003 + threads * 1009 + t);
+		std::array<OperationResult, NUMBER_OF_OPERATIONS> operations;
+		const auto start = Clock::now();
+		for(uint64_t i = 0; ; ++i)
+		{
+			// Checking the clock every 64 ops keeps its cost out of the measurement
+			if((i & 63) == 0 && Clock::now() - start > duration) break;
+
+			const uint32_t draw = rng() % totalWeight;
+			const std::size_t op = std::upper_bound(thresholds.begin(), thresholds.end(), draw) - thresholds.begin();
+			const StressEntry& e = entries[rng() % entries.size()];
+
+			bool isExpected = true;
+			bool isConsistent = true;
+			const auto opStart = Clock::now();
+			switch (static_cast<Operation>(op))
+			{
+			case Operation::GET:
+				isExpected = getAndCheck(e, cfg.arrayLength, isConsistent);
+				break;
+			case Operation::UPDATE:
+			case Operation::HARD_UPDATE:
+			{
+				const ReturnCodeRaw rc = updateByType(e, rng() % getValueRange(e.type), cfg.arrayLength, op == static_cast<std::size_t>(Operation::HARD_UPDATE)).getRawEnum();
+				if(!e.isWritable) isExpected = rc == ReturnCodeRaw::NOT_WRITABLE;
+				else isExpected = rc == ReturnCodeRaw::OK || (rc == ReturnCodeRaw::KEY_NOT_FOUND && e.isErasable);
+				break;
+			}
+			case Operation::ERASE:
+				isExpected = IDatabase::getInstance().erase(erasableEntries[rng() % erasableEntries.size()]->key).getRawEnum() == ReturnCodeRaw::OK;
+				break;
+			case Operation::RESTORE:
+			{
+				// Nothing to restore is fine, the key may never have been written or was restored already
+				const ReturnCodeRaw rc = IDatabase::getInstance().restore(e.key).getRawEnum();
+				isExpected = rc == ReturnCodeRaw::OK || rc == ReturnCodeRaw::KEY_NOT_FOUND;
+				break;
+			}
+			case Operation::RESET:
+				isExpected = IDatabase::getInstance().reset().getRawEnum() == ReturnCodeRaw::OK;
+				break;
+			default:
+				break;
+			}
+			const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - opStart).count();
+
+			OperationResult& result = operations[op];
+			++result.ops;
+			++result.latency.buckets[LatencyHistogram::getBucket(ns)];
+			++result.latency.count;
+			result.latency.totalNs += ns;
+			result.latency.maxNs = std::max(result.latency.maxNs, ns);
+			if(!isExpected)
+			{
+				++result.unexpectedRcs;
+				reportViolation(std::string("unexpected return code of ") + OPERATION_NAMES[op] + " " + e.key);
+			}
+			if(!isExpected || !isConsistent) violations.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		std::scoped_lock<std::mutex> lock(resultMutex);
+		for(std::size_t op = 0; op < NUMBER_OF_OPERATIONS; ++op)
+		{
+			step.operations[op].ops += operations[op].ops;
+			step.operations[op].unexpectedRcs += operations[op].unexpectedRcs;
+			merge(step.operations[op].latency, operations[op].latency);
+		}
+	};
+
+	const DatabaseStats statsBefore = IDatabase::getInstance().stats();
+	const auto start = Clock::now();
+	std::vector<std::thread> workers;
+	for(uint32_t t = 0; t < threads; ++t) workers.emplace_back(worker, t);
+	for(auto& w : workers) w.join();
+	step.elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	const DatabaseStats statsAfter = IDatabase::getInstance().stats();
+
+	for(const auto& operation : step.operations)
+	{
+		step.all.ops += operation.ops;
+		step.all.unexpectedRcs += operation.unexpectedRcs;
+		merge(step.all.latency, operation.latency);
+	}
+	step.violations = violations;
+	step.lockWait = subtract(statsAfter.lockWait, statsBefore.lockWait);
+	step.contendedLocks = step.lockWait.count;
+	step.uncontendedLocks = statsAfter.uncontendedLocks - statsBefore.uncontendedLocks;
+	return step;
+}
+
+uint64_t verifyOriginalDb(const std::vector<StressEntry>& entries, uint32_t arrayLength)
+{
+	uint64_t violations = 0;
+	for(const auto& e : entries)
+	{
+		bool isConsistent = true;
+		const bool isFound = getAndCheck(e, arrayLength, isConsistent) && isConsistent;
+
+		// Every generation of an entry passes getAndCheck(), compare with the original one as well
+		const bool isOriginal = isFound && [&e, arrayLength]{
+			if(e.type != "CHAR")
+			{
+				std::vector<uint64_t> values;
+				if(e.type == "U64") (void)IDatabase::getInstance().get(e.key, values);
+				else return true; // Checked through the U64 entries, the other types only differ by their size
+				return values.size() == arrayLength && values.back() == e.originalGeneration;
+			}
+
+			std::vector<std::string> values;
+			(void)IDatabase::getInstance().get(e.key, values);
+			return values.size() == arrayLength + 1 && values[1] == "g" + std::to_string(e.originalGeneration);
+		}();
+
+		if(!isFound || !isOriginal)
+		{
+			reportViolation("entry " + e.key + " does not hold its original values");
+			++violations;
+		}
+	}
+	return violations;
+}
+
+void merge(LatencyHistogram& into, const LatencyHistogram& from)
+{
+	for(std::size_t i = 0; i < LatencyHistogram::NUMBER_OF_BUCKETS; ++i) into.buckets[i] += from.buckets[i];
+	into.count += from.count;
+	into.totalNs += from.totalNs;
+	into.maxNs = std::max(into.maxNs, from.maxNs);
+}
+
+LatencyHistogram subtract(const LatencyHistogram& after, const LatencyHistogram& before)
+{
+	LatencyHistogram delta;
+	for(std::size_t i = 0; i < LatencyHistogram::NUMBER_OF_BUCKETS; ++i) delta.buckets[i] = after.buckets[i] - before.buckets[i];
+	delta.count = after.count - before.count;
+	delta.totalNs = after.totalNs - before.totalNs;
+	delta.maxNs = after.maxNs; // Cumulative, an upper bound of the maximum of the step
+	return delta;
+}
+
+void printResults(const std::vector<StepResult>& results, const StressConfig& cfg, uint64_t finalViolations)
+{
+	const double baseOpsPerSec = results.front().all.ops * 1e9 / results.front().elapsedNs;
+
+	// One row per thread count and operation, the "all" row carries the scaling, lock contention and violations of the step
+	struct Row
+	{
+		uint32_t threads;
+		std::string name;
+		const OperationResult* result;
+		const StepResult* step;
+	};
+	std::vector<Row> rows;
+	for(const auto& step : results)
+	{
+		rows.push_back({step.threads, "all", &step.all, &step});
+		for(std::size_t op = 0; op < NUMBER_OF_OPERATIONS; ++op)
+		{
+			if(step.operations[op].ops) rows.push_back({step.threads, OPERATION_NAMES[op], &step.operations[op], nullptr});
+		}
+	}
+
+	if(cfg.outputFormat == "json")
+	{
+		// One JSON object per line, easy to diff and to load in any dashboard
+		for(const auto& step : results)
+		{
+			for(const auto& r : rows)
+			{
+				if(r.threads != step.threads) continue;
+				std::cout << std::fixed << std::setprecision(1)
+					<< "{\"threads\":" << r.threads << ",\"operation\":\"" << r.name << "\",\"ops\":" << r.result->ops
+					<< ",\"ops_per_sec\":" << r.result->ops * 1e9 / step.elapsedNs << ",\"p50_ns\":" << r.result->latency.getPercentileNs(50)
+					<< ",\"p99_ns\":" << r.result->latency.getPercentileNs(99) << ",\"p999_ns\":" << r.result->latency.getPercentileNs(99.9)
+					<< ",\"max_ns\":" << r.result->latency.maxNs << ",\"unexpected_rcs\":" << r.result->unexpectedRcs;
+				if(r.step)
+				{
+					std::cout << ",\"speedup\":" << step.all.ops * 1e9 / step.elapsedNs / baseOpsPerSec << ",\"contended_locks\":" << step.contendedLocks
+						<< ",\"uncontended_locks\":" << step.uncontendedLocks << ",\"lock_wait_p99_ns\":" << step.lockWait.getPercentileNs(99)
+						<< ",\"violations\":" << step.violations;
+				}
+				std::cout << "}" << std::endl;
+			}
+		}
+		std::cout << "{\"final_violations\":" << finalViolations << "}" << std::endl;
+	}
+	else if(cfg.outputFormat == "csv")
+	{
+		std::cout << "threads,operation,ops,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns,unexpected_rcs,speedup,contended_locks,uncontended_locks,lock_wait_p99_ns,violations" << std::endl;
+		for(const auto& step : results)
+		{
+			for(const auto& r : rows)
+			{
+				if(r.threads != step.threads) continue;
+				std::cout << std::fixed << std::setprecision(1) << r.threads << "," << r.name << "," << r.result->ops << "," << r.result->ops * 1e9 / step.elapsedNs
+					<< "," << r.result->latency.getPercentileNs(50) << "," << r.result->latency.getPercentileNs(99) << "," << r.result->latency.getPercentileNs(99.9)
+					<< "," << r.result->latency.maxNs << "," << r.result->unexpectedRcs;
+				if(r.step)
+				{
+					std::cout << "," << step.all.ops * 1e9 / step.elapsedNs / baseOpsPerSec << "," << step.contendedLocks << "," << step.uncontendedLocks
+						<< "," << step.lockWait.getPercentileNs(99) << "," << step.violations;
+				}
+				else std::cout << ",,,,,";
+				std::cout << std::endl;
+			}
+		}
+	}
+	else
+	{
+		std::cout << "Synthetic DB: " << cfg.numberOfEntries << " entries, depth " << cfg.keyDepth << ", " << cfg.arrayLength << " values per entry, seed " << cfg.seed
+			<< ", " << cfg.durationMs << " ms per thread count" << std::endl;
+		std::cout << std::left << std::setw(10) << "operation" << std::right << std::setw(8) << "threads" << std::setw(12) << "ops" << std::setw(14) << "ops/s"
+			<< std::setw(9) << "speedup" << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns" << std::setw(12) << "p999 ns" << std::setw(12) << "max ns"
+			<< std::setw(12) << "lock waits" << std::setw(14) << "wait p99 ns" << std::setw(11) << "violations" << std::endl;
+		for(const auto& step : results)
+		{
+			for(const auto& r : rows)
+			{
+				if(r.threads != step.threads) continue;
+				std::cout << std::fixed << std::setprecision(1) << std::left << std::setw(10) << r.name << std::right << std::setw(8) << r.threads
+					<< std::setw(12) << r.result->ops << std::setw(14) << r.result->ops * 1e9 / step.elapsedNs;
+				if(r.step) std::cout << std::setw(9) << std::setprecision(2) << step.all.ops * 1e9 / step.elapsedNs / baseOpsPerSec << std::setprecision(1);
+				else std::cout << std::setw(9) << "";
+				std::cout << std::setw(12) << r.result->latency.getPercentileNs(50) << std::setw(12) << r.result->latency.getPercentileNs(99)
+					<< std::setw(12) << r.result->latency.getPercentileNs(99.9) << std::setw(12) << r.result->latency.maxNs;
+				if(r.step) std::cout << std::setw(12) << step.contendedLocks << std::setw(14) << step.lockWait.getPercentileNs(99) << std::setw(11) << step.violations;
+				else std::cout << std::setw(37) << r.result->unexpectedRcs;
+				std::cout << std::endl;
+			}
+		}
+		std::cout << "Violations after the final reset: " << finalViolations << std::endl;
+	}
+}
@@ -2,11 +2,25 @@
 #include <optional>
 #include <string>
 #include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #include "databaseIf.h"
 
 using namespace DbEngine::DatabaseIf::V1;
 
+// Counts every malloc() of the process (glibc), operator new and the database library included
+static std::atomic<std::size_t> numberOfMallocs {0};
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* malloc(std::size_t size) noexcept
+{
+	numberOfMallocs.fetch_add(1, std::memory_order_relaxed);
+	return __libc_malloc(size);
+}
+
 int main()
 {
 	const std::string key1 { "/isFeatureXyzEnabled" };
@@ -132,6 +146,257 @@ int main()
 		std::cout << "[DEBUG]: Reading DB key (" << key3 << "): " << it.value() << std::endl;
 	}
 
+	const LoadStats loadStats = IDatabase::getInstance().loadStats();
+	std::cout << "[DEBUG]: Loaded " << loadStats.numberOfEntries << " entries (" << loadStats.numberOfUniqueValues << " unique values) of DB revision "
+		<< loadStats.dbRevision << ", " << loadStats.numberOfConversionFailures << " conversion failures" << std::endl;
+
+	const MemoryUsage memoryUsage = IDatabase::getInstance().memoryUsage(1);
+	std::cout << "[DEBUG]: Memory usage: " << memoryUsage.original.entries.count << " entries, " << memoryUsage.original.values.count << " values, prefixes:";
+	for(const auto& [prefix, usage] : memoryUsage.perPrefix)
+	{
+		std::cout << " " << prefix << " " << usage.count;
+	}
+	std::cout << ", total bytes > 0: " << (memoryUsage.totalBytes > 0) << std::endl;
+
+	IDatabase::getInstance().enableHotKeyTracking(1, 16);
+	for(int i = 0; i < 3; ++i) (void)IDatabase::getInstance().autoGet<uint16_t>(key3);
+	(void)IDatabase::getInstance().autoGet<uint8_t>(key1);
+	(void)IDatabase::getInstance().autoGet<uint8_t>("/missingKey");
+	const HotKeyReport hotKeys = IDatabase::getInstance().hotKeys(1);
+	std::cout << "[DEBUG]: Hottest read key: " << (hotKeys.reads.empty() ? "" : hotKeys.reads.front().key)
+		<< " (" << (hotKeys.reads.empty() ? 0 : hotKeys.reads.front().count) << " reads), "
+		<< hotKeys.misses.size() << " missed key" << std::endl;
+	IDatabase::getInstance().enableHotKeyTracking(0);
+
+	IDatabase::getInstance().enableStats(true);
+	std::cout << "[DEBUG]: Reading uint8_t DB key " << key1 << ", uint16_t DB key " << key1 << " and /missingKey with statistics on" << std::endl;
+	(void)IDatabase::getInstance().autoGet<uint8_t>(key1);
+	(void)IDatabase::getInstance().autoGet<uint16_t>(key1);
+	(void)IDatabase::getInstance().autoGet<uint8_t>("/missingKey");
+	const DatabaseStats stats = IDatabase::getInstance().stats();
+	std::cout << "[DEBUG]: Statistics: get " << stats.get.count << ", type mismatch " << stats.typeMismatch
+		<< ", key not found " << stats.keyNotFound << " (" << stats.filterRejects << " rejected by the filter)"
+		<< ", p99 <= max " << (stats.get.getPercentileNs(99) <= stats.get.maxNs) << std::endl;
+	IDatabase::getInstance().enableStats(false);
+
+	std::vector<uint8_t> featureXyz;
+	std::vector<uint8_t> missing;
+	std::vector<uint16_t> supportedCapabilities;
+	std::vector<std::string> driverNames;
+	std::vector<GetRequest> requests {{key1, &featureXyz}, {key3, &supportedCapabilities}, {key4, &driverNames}, {"/missingKey", &missing}};
+	const ReturnCodeEnum rcMany = IDatabase::getInstance().getMany(requests);
+	std::cout << "[DEBUG]: Reading " << requests.size() << " DB keys at once: " << rcMany.toString() << ",";
+	for(const auto& request : requests)
+	{
+		std::cout << " " << request.rc.toString();
+	}
+	std::cout << ", " << +featureXyz.front() << " " << supportedCapabilities.front() << " " << driverNames.back() << std::endl;
+
+	std::cout << "[DEBUG]: Scanning DB keys under /sw/prod_1.14.12:";
+	IDatabase::getInstance().scan("/sw/prod_1.14.12", [](const ScanEntry& entry){
+		std::cout << " " << entry.key << (entry.isModified ? " (modified)" : "");
+		return true;
+	});
+	std::cout << std::endl;
+
+	std::cout << "[DEBUG]: Scanning string DB keys under /hw:";
+	const std::size_t numberOfStrings = IDatabase::getInstance().scan("/hw", [](const ScanEntry& entry){
+		std::cout << " " << entry.getValue<std::string_view>(entry.size() - 1).value_or("");
+		return true;
+	}, ValueType::CHAR);
+	std::cout << ", " << numberOfStrings << " visited, stopping after the first: "
+		<< IDatabase::getInstance().scan("/", [](const ScanEntry&){ return false; }) << " visited" << std::endl;
+
+	uint16_t capabilities[8];
+	char driverName[64];
+	std::size_t count = 0;
+	std::size_t length = 0;
+	(void)IDatabase::getInstance().get(key3, capabilities, count); // Let this thread set up its thread-local state first
+	const std::size_t numberOfMallocsBefore = numberOfMallocs.load();
+	const ReturnCodeEnum rc1 = IDatabase::getInstance().get(key3, capabilities, count);
+	const ReturnCodeEnum rc2 = IDatabase::getInstance().get(key4, driverName, length);
+	const ReturnCodeEnum rc3 = IDatabase::getInstance().get("/missingKey", capabilities, count);
+	const std::size_t numberOfMallocsOnGet = numberOfMallocs.load() - numberOfMallocsBefore;
+	std::cout << "[DEBUG]: Real-time get: " << rc1.toString() << " " << capabilities[0] << ", " << rc2.toString() << " " << driverName
+		<< ", " << rc3.toString() << ", " << numberOfMallocsOnGet << " allocations" << std::endl;
+	if(numberOfMallocsOnGet != 0)
+	{
+		std::cerr << "[ERROR]: Real-time get allocated " << numberOfMallocsOnGet << " times" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::string flagKey = "/sw/prod_1.14.12/isFeatureXyzEnabled";
+	uint8_t flag = 0;
+	const ReturnCodeEnum rcFirstSet = IDatabase::getInstance().setScalar(flagKey, uint8_t {0}); // Creates its Modified DB entry
+	const std::size_t numberOfMallocsBeforeScalar = numberOfMallocs.load();
+	const ReturnCodeEnum rcSet = IDatabase::getInstance().setScalar(flagKey, uint8_t {5});
+	const ReturnCodeEnum rcGet = IDatabase::getInstance().getScalar(flagKey, flag);
+	const std::size_t numberOfMallocsOnScalar = numberOfMallocs.load() - numberOfMallocsBeforeScalar;
+	std::cout << "[DEBUG]: Scalar set and get of " << flagKey << ": " << rcFirstSet.toString() << " " << rcSet.toString() << " "
+		<< rcGet.toString() << " " << +flag << ", get() reads " << +IDatabase::getInstance().autoGet<uint8_t>(key1).value_or(0)
+		<< ", " << numberOfMallocsOnScalar << " allocations" << std::endl;
+	if(numberOfMallocsOnScalar != 0)
+	{
+		std::cerr << "[ERROR]: Scalar set and get allocated " << numberOfMallocsOnScalar << " times" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	(void)IDatabase::getInstance().restore(flagKey);
+	const ReturnCodeEnum rcRestored = IDatabase::getInstance().getScalar(flagKey, flag);
+	const ReturnCodeEnum rcPartial = IDatabase::getInstance().getScalar(key3, capabilities[0]);
+	const ReturnCodeEnum rcMismatch = IDatabase::getInstance().getScalar(flagKey, capabilities[0]);
+	std::cout << "[DEBUG]: Scalar get after restore: " << rcRestored.toString() << " " << +flag << ", of partial key " << key3 << ": "
+		<< rcPartial.toString() << " " << capabilities[0] << ", as uint16_t: " << rcMismatch.toString() << std::endl;
+
+	uint8_t previousFlag = 0;
+	const ReturnCodeEnum rcFirstAdd = IDatabase::getInstance().fetchAdd(flagKey, uint8_t {2}, previousFlag); // Creates its Modified DB entry
+	const ReturnCodeEnum rcAdd = IDatabase::getInstance().fetchAdd(flagKey, uint8_t {255}, previousFlag); // Wraps around to 2
+	uint8_t expectedFlag = 0;
+	const ReturnCodeEnum rcStale = IDatabase::getInstance().compareAndUpdate(flagKey, expectedFlag, uint8_t {7});
+	const ReturnCodeEnum rcSwapped = IDatabase::getInstance().compareAndUpdate(flagKey, expectedFlag, uint8_t {7});
+	(void)IDatabase::getInstance().getScalar(flagKey, flag);
+	std::cout << "[DEBUG]: Fetch-add of " << flagKey << ": " << rcFirstAdd.toString() << " " << rcAdd.toString() << " from " << +previousFlag
+		<< ", compare-and-update: " << rcStale.toString() << " (holds " << +expectedFlag << ") " << rcSwapped.toString() << " " << +flag << std::endl;
+	(void)IDatabase::getInstance().restore(flagKey);
+
+	const auto toString = [](std::optional<ChangeKind> kind){
+		if(!kind.has_value()) return "none";
+		switch (kind.value())
+		{
+		case ChangeKind::UPDATED: return "UPDATED";
+		case ChangeKind::ERASED: return "ERASED";
+		case ChangeKind::RESTORED: return "RESTORED";
+		case ChangeKind::RESET: return "RESET";
+		}
+		return "unknown";
+	};
+	std::mutex changesMutex;
+	std::condition_variable changesCv;
+	std::optional<ChangeKind> lastChange;
+	std::optional<ChangeKind> lastBatchedChange;
+	const SubscriptionId subscriptionId = IDatabase::getInstance().subscribe("/sw/prod_1.14.12", [&](const ChangeEvent& event){
+		std::scoped_lock<std::mutex> lock(changesMutex);
+		if(event.key == flagKey) lastChange = event.kind;
+		changesCv.notify_all();
+	});
+	const SubscriptionId batchSubscriptionId = IDatabase::getInstance().subscribeBatch(flagKey, [&](const std::vector<ChangeEvent>& events){
+		std::scoped_lock<std::mutex> lock(changesMutex);
+		lastBatchedChange = events.back().kind;
+		changesCv.notify_all();
+	});
+	(void)IDatabase::getInstance().setScalar(flagKey, uint8_t {3});
+	(void)IDatabase::getInstance().setScalar(flagKey, uint8_t {4});
+	(void)IDatabase::getInstance().erase(flagKey);
+	(void)IDatabase::getInstance().restore(flagKey);
+	{
+		// Changes are delivered asynchronously, possibly coalesced, the last one of the key is always delivered last
+		std::unique_lock<std::mutex> lock(changesMutex);
+		changesCv.wait_for(lock, std::chrono::seconds(5), [&]{
+			return lastChange == ChangeKind::RESTORED && lastBatchedChange == ChangeKind::RESTORED;
+		});
+	}
+	const bool isUnsubscribed = IDatabase::getInstance().unsubscribe(subscriptionId);
+	const bool isBatchUnsubscribed = IDatabase::getInstance().unsubscribe(batchSubscriptionId);
+	std::cout << "[DEBUG]: Change notifications of " << flagKey << ": " << toString(lastChange) << ", batched: " << toString(lastBatchedChange)
+		<< ", unsubscribe: " << isUnsubscribed << " " << isBatchUnsubscribed << " " << IDatabase::getInstance().unsubscribe(subscriptionId) << std::endl;
+
+	// A snapshot keeps reading the value of its version, getIfChanged() only copies values newer than the version passed
+	(void)IDatabase::getInstance().setScalar(flagKey, uint8_t {5});
+	const auto snapshot = IDatabase::getInstance().snapshot();
+	(void)IDatabase::getInstance().setScalar(flagKey, uint8_t {6});
+	std::vector<uint8_t> snapshotValues;
+	std::vector<uint8_t> currentValues;
+	const ReturnCodeEnum snapshotRc = snapshot->get(flagKey, snapshotValues);
+	(void)IDatabase::getInstance().get(flagKey, currentValues);
+	std::vector<uint8_t> changedValues;
+	uint64_t entryVersion = 0;
+	const ReturnCodeEnum changedRc = IDatabase::getInstance().getIfChanged(flagKey, 0, changedValues, entryVersion);
+	const ReturnCodeEnum unchangedRc = IDatabase::getInstance().getIfChanged(flagKey, entryVersion, changedValues, entryVersion);
+	std::cout << "[DEBUG]: Snapshot of " << flagKey << ": " << snapshotRc.toString() << " " << +snapshotValues.at(0) << " (current "
+		<< +currentValues.at(0) << ", " << (snapshot->version() < IDatabase::getInstance().version() ? "older" : "not older")
+		<< "), getIfChanged: " << changedRc.toString() << " " << +changedValues.at(0) << " then " << unchangedRc.toString()
+		<< (entryVersion == IDatabase::getInstance().version() ? " at the current version" : " at another version") << std::endl;
+	(void)IDatabase::getInstance().restore(flagKey);
+
+	// Cached reads are served until the next write, which is never missed
+	IDatabase::getInstance().enableReadCache(64);
+	IDatabase::getInstance().enableStats(true);
+	const uint64_t readCacheHitsBefore = IDatabase::getInstance().stats().readCacheHits;
+	std::vector<uint8_t> cachedValues;
+	(void)IDatabase::getInstance().get(flagKey, cachedValues);
+	(void)IDatabase::getInstance().get(flagKey, cachedValues);
+	std::vector<uint8_t> newFlagValues {7};
+	(void)IDatabase::getInstance().update(flagKey, newFlagValues, false);
+	(void)IDatabase::getInstance().get(flagKey, cachedValues);
+	std::cout << "[DEBUG]: Read cache of " << flagKey << ": " << +cachedValues.at(0) << " after update, "
+		<< IDatabase::getInstance().stats().readCacheHits - readCacheHitsBefore << " hit(s)" << std::endl;
+	IDatabase::getInstance().enableStats(false);
+	IDatabase::getInstance().enableReadCache(0);
+	(void)IDatabase::getInstance().restore(flagKey);
+
+	// Erasing only sets a bit, the Modified DB does not grow
+	const uint64_t modifiedEntriesBefore = IDatabase::getInstance().memoryUsage().modified.entries.count;
+	(void)IDatabase::getInstance().erase(flagKey);
+	const MemoryUsage erasedUsage = IDatabase::getInstance().memoryUsage();
+	const ReturnCodeEnum erasedRc = IDatabase::getInstance().getScalar(flagKey, flag);
+	const ReturnCodeEnum restoredRc = IDatabase::getInstance().restore(flagKey);
+	const ReturnCodeEnum unerasedRc = IDatabase::getInstance().getScalar(flagKey, flag);
+	std::cout << "[DEBUG]: Erase of " << flagKey << ": " << erasedRc.toString() << ", " << erasedUsage.original.erasedBits.count << " erased, "
+		<< erasedUsage.modified.entries.count - modifiedEntriesBefore << " new Modified DB entries, restore: " << restoredRc.toString() << " "
+		<< unerasedRc.toString() << " " << +flag << std::endl;
+
+	// Whole keys made of the same sub-keys stay distinct entries, whichever of them is in the Modified DB
+	const std::string fanBoardKey = "/hw/prod_1.14.12/fan/board/dutyCycles";
+	const std::string boardFanKey = "/hw/prod_1.14.12/board/fan/dutyCycles";
+	std::vector<uint16_t> boardFanValues {11, 22};
+	std::vector<uint16_t> fanBoardValues;
+	std::vector<uint16_t> erasedValues;
+	(void)IDatabase::getInstance().update(boardFanKey, boardFanValues, false);
+	(void)IDatabase::getInstance().get(fanBoardKey, fanBoardValues);
+	(void)IDatabase::getInstance().erase(fanBoardKey);
+	const ReturnCodeEnum erasedFanBoardRc = IDatabase::getInstance().get(fanBoardKey, erasedValues);
+	const ReturnCodeEnum boardFanRc = IDatabase::getInstance().get(boardFanKey, boardFanValues);
+	(void)IDatabase::getInstance().restore(fanBoardKey);
+	const ReturnCodeEnum restoredFanBoardRc = IDatabase::getInstance().restore(fanBoardKey);
+	(void)IDatabase::getInstance().restore(boardFanKey);
+	std::cout << "[DEBUG]: After update of " << boardFanKey << " to 11 22, " << fanBoardKey << ": " << fanBoardValues.at(0) << " " << fanBoardValues.at(1)
+		<< " " << fanBoardValues.at(2) << ", erase: " << erasedFanBoardRc.toString() << " and " << boardFanRc.toString() << " " << boardFanValues.at(0)
+		<< " " << boardFanValues.at(1) << ", second restore: " << restoredFanBoardRc.toString() << std::endl;
+
+	// Board specific keys without an entry of their own read the longest whole key they continue, writes never fall back
+	const std::string boardFanSpeedKey = "/hw/prod_1.14.12/fanSpeed/board7";
+	std::vector<uint16_t> fanSpeedValues {1500, 3000};
+	std::vector<uint16_t> boardFanSpeedValues;
+	std::vector<uint16_t> boardLimitsValues;
+	std::vector<uint16_t> noBoundaryValues;
+	const ReturnCodeEnum boardUpdateRc = IDatabase::getInstance().update(boardFanSpeedKey, fanSpeedValues, false);
+	(void)IDatabase::getInstance().update("/hw/prod_1.14.12/fanSpeed", fanSpeedValues, false);
+	(void)IDatabase::getInstance().get(boardFanSpeedKey, boardFanSpeedValues);
+	(void)IDatabase::getInstance().get("/hw/prod_1.14.12/fanSpeed/limits/board7", boardLimitsValues);
+	const ReturnCodeEnum noBoundaryRc = IDatabase::getInstance().get("/hw/prod_1.14.12/fanSpeedX", noBoundaryValues);
+	(void)IDatabase::getInstance().restore("/hw/prod_1.14.12/fanSpeed");
+	std::cout << "[DEBUG]: Fallback of " << boardFanSpeedKey << ": " << boardFanSpeedValues.at(0) << " " << boardFanSpeedValues.at(1)
+		<< ", of its limits: " << boardLimitsValues.at(0) << " " << boardLimitsValues.at(1) << ", without sub-key boundary: "
+		<< noBoundaryRc.toString() << ", update: " << boardUpdateRc.toString() << std::endl;
+
+	// Accessors generated by textToBin -g read by entry id, id 0 is the first key of the text DB
+	const uint64_t dbChecksum = IDatabase::getInstance().loadStats().checksum;
+	uint8_t flagById = 0;
+	uint16_t wideFlagById = 0;
+	std::size_t flagCount = 0;
+	const ReturnCodeEnum originalByIdRc = IDatabase::getInstance().getScalarById({0, dbChecksum}, flagById);
+	const uint8_t originalFlagById = flagById;
+	(void)IDatabase::getInstance().setScalar(flagKey, uint8_t {9});
+	const ReturnCodeEnum updatedByIdRc = IDatabase::getInstance().getById({0, dbChecksum}, &flagById, 1, flagCount);
+	const ReturnCodeEnum outOfRangeRc = IDatabase::getInstance().getScalarById({1000000, dbChecksum}, flagById);
+	const ReturnCodeEnum wideByIdRc = IDatabase::getInstance().getScalarById({0, dbChecksum}, wideFlagById);
+	const ReturnCodeEnum otherDbRc = IDatabase::getInstance().getById({0, dbChecksum + 1}, &flagById, 1, flagCount);
+	const bool isOtherDbRejected = !IDatabase::getInstance().autoGetById<uint8_t>({0, dbChecksum + 1}).has_value();
+	(void)IDatabase::getInstance().restore(flagKey);
+	std::cout << "[DEBUG]: Get by id 0: " << originalByIdRc.toString() << " " << +originalFlagById << ", after update: " << updatedByIdRc.toString()
+		<< " " << +flagById << ", out of range: " << outOfRangeRc.toString() << ", as uint16_t: " << wideByIdRc.toString()
+		<< ", other DB: " << otherDbRc.toString() << " " << flagCount << " nullopt " << isOtherDbRejected << std::endl;
+
 	// std::cout << "[DEBUG]: Restoring uint16_t DB key " << key3 << std::endl;
 	// IDatabase::getInstance().restore(key3);
 
@@ -0,0 +1,90 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Register-blocked Bloom filter: every string sets BITS_PER_STRING bits of a single 64-bit word, so a lookup is one hash and
+// one memory access. mayContain() is true for everything until reset() sized the filter. Not thread-safe for writes, concurrent reads are fine.
+class BloomFilter
+{
+public:
+	BloomFilter() = default;
+	~BloomFilter() = default;
+
+	BloomFilter(const BloomFilter& other) = delete;
+	BloomFilter(BloomFilter&& other) = delete;
+	BloomFilter& operator=(const BloomFilter& other) = delete;
+	BloomFilter& operator=(BloomFilter&& other) = delete;
+
+	// Drop all strings and size the filter for expectedStrings
+	void reset(std::size_t expectedStrings);
+
+	void insert(std::string_view str)
+	{
+		if(m_words.empty()) return;
+
+		const uint64_t hash = std::hash<std::string_view>{}(str);
+		m_words[getWordIndex(hash)] |= getMask(hash);
+	}
+
+	bool mayContain(std::string_view str) const
+	{
+		if(m_words.empty()) return true;
+
+		const uint64_t hash = std::hash<std::string_view>{}(str);
+		const uint64_t mask = getMask(hash);
+		return (m_words[getWordIndex(hash)] & mask) == mask;
+	}
+
+	uint64_t getNumberOfBytes() const { return m_words.capacity() * sizeof(uint64_t); }
+
+	// False positive rate for numberOfStrings inserted strings
+	double getFalsePositiveRate(std::size_t numberOfStrings) const;
+
+private:
+	static constexpr uint32_t BITS_PER_STRING = 4;
+	static constexpr uint32_t WORD_BITS_PER_STRING = 16; // At least, the number of words is rounded up to a power of 2
+
+	// The low bits of the hash pick the word, the high bits the bit positions within it
+	std::size_t getWordIndex(uint64_t hash) const
+	{
+		return hash & (m_words.size() - 1);
+	}
+
+	static uint64_t getMask(uint64_t hash)
+	{
+		uint64_t mask = 0;
+		for(uint32_t i = 0; i < BITS_PER_STRING; ++i)
+		{
+			mask |= uint64_t {1} << ((hash >> (40 + 6 * i)) & 63);
+		}
+		return mask;
+	}
+
+	std::vector<uint64_t> m_words; // Power of 2 words, empty until reset()
+
+}; // class BloomFilter
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,99 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <semaphore.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "databaseIf.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Change notifications of IDatabase::subscribe(). Writers push their changes onto a lock-free stack and post a semaphore when
+// it was empty, both of which never block. A dispatcher thread, started with the first subscription, takes the whole stack at
+// once, coalesces repeated keys and runs the callbacks of the matching subscriptions without holding any DB lock.
+class ChangeNotifier
+{
+public:
+	using EventCallback = std::function<void(const ChangeEvent&)>;
+	using BatchCallback = std::function<void(const std::vector<ChangeEvent>&)>;
+
+	ChangeNotifier();
+	~ChangeNotifier();
+
+	ChangeNotifier(const ChangeNotifier& other) = delete;
+	ChangeNotifier(ChangeNotifier&& other) = delete;
+	ChangeNotifier& operator=(const ChangeNotifier& other) = delete;
+	ChangeNotifier& operator=(ChangeNotifier&& other) = delete;
+
+	bool hasSubscriptions() const
+	{
+		return m_numberOfSubscriptions.load(std::memory_order_relaxed) > 0;
+	}
+
+	// Lock-free, safe to call with DB locks held
+	void publish(std::string_view key, ChangeKind kind);
+
+	// Exactly one of callback and batchCallback is set
+	SubscriptionId subscribe(std::string_view prefix, EventCallback callback, BatchCallback batchCallback);
+	bool unsubscribe(SubscriptionId id);
+
+private:
+	struct Node
+	{
+		std::string key;
+		ChangeKind kind;
+		Node* next;
+	};
+
+	struct Subscription
+	{
+		SubscriptionId id;
+		std::string prefix;
+		EventCallback callback;
+		BatchCallback batchCallback;
+		std::atomic<bool> isActive {true}; // Cleared by unsubscribe(), checked before every call
+	};
+
+	void run();
+	void deliver(const std::vector<ChangeEvent>& events);
+	static void deleteNodes(Node* node);
+
+	std::atomic<Node*> m_head {nullptr}; // Most recent change first
+	sem_t m_wakeUp;
+	std::atomic<bool> m_isStopped {false};
+	std::thread m_thread; // Started by the first subscribe()
+
+	std::mutex m_subscriptionsMutex;
+	std::vector<std::shared_ptr<Subscription>> m_subscriptions;
+	SubscriptionId m_nextId {1};
+	std::atomic<std::size_t> m_numberOfSubscriptions {0};
+	std::mutex m_deliveryMutex; // Held by the dispatcher while it runs callbacks, so that unsubscribe() can wait for them
+
+}; // class ChangeNotifier
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -12,14 +12,30 @@
 #include <cstdio>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
 #include <any>
 #include <type_traits>
+#include <cstring>
 
 #include "databaseIf.h"
+#include "stringArena.h"
+#include "dbStats.h"
+#include "dbTrace.h"
+#include "hotKeyTracker.h"
+#include "keyIndex.h"
+#include "bloomFilter.h"
+#include "changeNotifier.h"
+#include "readCache.h"
+#include "erasedBitmap.h"
 
 #include <enumUtils.h>
 #include <stringUtils.h>
@@ -131,6 +147,8 @@ public:
 class DbLoader
 {
 public:
+	struct Snapshot;
+
 	static DbLoader& getInstance();
 
 	DbLoader(const DbLoader& other) = delete;
@@ -140,10 +158,195 @@ public:
 
 	template<typename T>
 	std::vector<T> retrieve(const std::string& key, ReturnCodeEnum& rc)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		std::vector<T> values = m_readCache.isEnabled() ? retrieveCached<T>(key, rc) : retrieveEntry<T>(key, rc);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(key, rc, HotKeyTracker::Access::READ);
+		return values;
+	}
+
+	template<typename T>
+	ReturnCodeEnum update(const std::string& key, std::vector<T>& values, bool isHardWrite)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		ReturnCodeEnum rc = updateEntry<T>(key, values, isHardWrite);
+		m_stats.endOperation(isHardWrite ? DbStats::Operation::HARD_UPDATE : DbStats::Operation::SOFT_UPDATE, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(key, rc, HotKeyTracker::Access::WRITE);
+		return rc;
+	}
+	
+	ReturnCodeEnum restore(const std::string& key);
+	ReturnCodeEnum resetToDefault();
+	ReturnCodeEnum erase(const std::string& key);
+
+	// Real-time read path, see IDatabase::get(key, values, capacity, count). Unlike retrieve() it does not allocate,
+	// trace or feed the hot-key tracker, the stats hooks are kept since they never allocate either.
+	template<typename T>
+	ReturnCodeEnum retrieveInto(std::string_view key, T* values, std::size_t capacity, std::size_t& count)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = copyEntryValues<T>(key, values, capacity, count);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		return rc;
+	}
+
+	bool lockMemory();
+
+	// Single-value entries of up to 32 bits, see IDatabase::getScalar()/setScalar()
+	template<typename T>
+	ReturnCodeEnum retrieveScalar(std::string_view key, T& value)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = readScalar<T>(key, value);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(std::string(key), rc, HotKeyTracker::Access::READ);
+		return rc;
+	}
+
+	// Reads by entry id, see IDatabase::getById(). Like retrieveInto() they neither allocate nor feed the hot-key tracker.
+	// The position of an id generated from another DB image would silently name another entry, so it is checked against the checksum first.
+	template<typename T>
+	ReturnCodeEnum retrieveIntoById(const EntryId& id, T* values, std::size_t capacity, std::size_t& count)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		count = 0;
+		const ReturnCodeEnum rc = id.dbChecksum == m_loadStats.checksum ? copyEntryValuesById<T>(id.position, values, capacity, count)
+			: ReturnCodeEnum(ReturnCodeRaw::DB_MISMATCH);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum retrieveScalarById(const EntryId& id, T& value)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = id.dbChecksum == m_loadStats.checksum ? readScalarById<T>(id.position, value)
+			: ReturnCodeEnum(ReturnCodeRaw::DB_MISMATCH);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum updateScalar(std::string_view key, T value, bool isHardWrite)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = writeScalar<T>(key, value, isHardWrite);
+		m_stats.endOperation(isHardWrite ? DbStats::Operation::HARD_UPDATE : DbStats::Operation::SOFT_UPDATE, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(std::string(key), rc, HotKeyTracker::Access::WRITE);
+		return rc;
+	}
+
+	// Read-modify-write of single-value entries, see IDatabase::compareAndUpdate()/fetchAdd()
+	template<typename T>
+	ReturnCodeEnum compareAndUpdate(std::string_view key, T& expected, T desired, bool isHardWrite)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = modifyScalar<T>(key, [&expected, desired](T current, T& next){
+			if(current != expected)
+			{
+				expected = current;
+				return ReturnCodeEnum(ReturnCodeRaw::VALUE_MISMATCH);
+			}
+
+			next = desired;
+			return ReturnCodeEnum(ReturnCodeRaw::OK);
+		}, isHardWrite);
+		m_stats.endOperation(isHardWrite ? DbStats::Operation::HARD_UPDATE : DbStats::Operation::SOFT_UPDATE, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(std::string(key), rc, HotKeyTracker::Access::WRITE);
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum fetchAdd(std::string_view key, T delta, T& previousValue, bool isHardWrite)
+	{
+		static_assert(std::is_integral<T>::value, "fetchAdd() is only defined for integral entries");
+
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = modifyScalar<T>(key, [&previousValue, delta](T current, T& next){
+			// Added as unsigned so that signed entries wrap around instead of overflowing
+			using U = typename std::make_unsigned<T>::type;
+			previousValue = current;
+			next = static_cast<T>(static_cast<U>(current) + static_cast<U>(delta));
+			return ReturnCodeEnum(ReturnCodeRaw::OK);
+		}, isHardWrite);
+		m_stats.endOperation(isHardWrite ? DbStats::Operation::HARD_UPDATE : DbStats::Operation::SOFT_UPDATE, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(std::string(key), rc, HotKeyTracker::Access::WRITE);
+		return rc;
+	}
+
+	ReturnCodeEnum retrieveMany(std::vector<GetRequest>& requests);
+
+	// Versions and snapshots, see IDatabase::version()/snapshot()/getIfChanged()
+	uint64_t getVersion() const { return m_writeSequence.load(std::memory_order_acquire) >> VERSION_SHIFT; }
+	std::shared_ptr<const Snapshot> takeSnapshot();
+
+	template<typename T>
+	ReturnCodeEnum retrieveFromSnapshot(const Snapshot& snapshot, const std::string& key, std::vector<T>& values)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = copySnapshotValues<T>(snapshot, key, values);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(key, rc, HotKeyTracker::Access::READ);
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum retrieveIfChanged(const std::string& key, uint64_t sinceVersion, std::vector<T>& values, uint64_t& entryVersion)
+	{
+		const uint64_t startNs = m_stats.startOperation();
+		const ReturnCodeEnum rc = copyChangedValues<T>(key, sinceVersion, values, entryVersion);
+		m_stats.endOperation(DbStats::Operation::GET, startNs, rc);
+		if(m_hotKeys.isSampled()) recordHotKey(key, rc, HotKeyTracker::Access::READ);
+		return rc;
+	}
+
+	std::size_t scan(std::string_view prefix, const std::function<bool(const ScanEntry&)>& visitor, std::optional<ValueType> type);
+
+	void enableStats(bool isEnabled) { m_stats.setEnabled(isEnabled); }
+	void enableReadCache(std::size_t capacity) { m_readCache.enable(capacity); }
+	DatabaseStats getStats() const { return m_stats.getSnapshot(); }
+	LoadStats getLoadStats() const { return m_loadStats; }
+	MemoryUsage getMemoryUsage(uint32_t prefixDepth);
+
+	void enableHotKeyTracking(uint32_t samplingPeriod, std::size_t capacity) { m_hotKeys.enable(samplingPeriod, capacity); }
+	HotKeyReport getHotKeys(std::size_t topK) const { return m_hotKeys.getReport(topK); }
+	bool exportHotKeys(const std::string& filePath, std::size_t topK) const;
+
+	SubscriptionId subscribe(std::string_view prefix, ChangeNotifier::EventCallback callback, ChangeNotifier::BatchCallback batchCallback)
+	{
+		return m_notifier.subscribe(prefix, std::move(callback), std::move(batchCallback));
+	}
+
+	bool unsubscribe(SubscriptionId id) { return m_notifier.unsubscribe(id); }
+
+private:
+	template<typename T>
+	std::vector<T> retrieveCached(const std::string& key, ReturnCodeEnum& rc)
+	{
+		// Loaded before the entry is read, a write in between already stales the cached copy
+		const uint64_t version = getVersion();
+
+		std::vector<T> values;
+		if(m_readCache.find<T>(key, version, values))
+		{
+			m_stats.count(DbStats::Counter::READ_CACHE_HITS);
+			rc.set(ReturnCodeRaw::OK);
+			return values;
+		}
+
+		values = retrieveEntry<T>(key, rc);
+		if(rc.getRawEnum() == ReturnCodeRaw::OK) m_readCache.insert<T>(key, version, values);
+		return values;
+	}
+
+	template<typename T>
+	std::vector<T> retrieveEntry(const std::string& key, ReturnCodeEnum& rc)
 	{
 		rc.set(ReturnCodeRaw::OK);
 
-		const auto& it = findMatchingIndices(key);
+		auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
+		const auto& it = findMatchingIndices(key, true);
 		if(!it.has_value())
 		{
 			rc.set(ReturnCodeRaw::KEY_NOT_FOUND);
@@ -153,80 +356,494 @@ public:
 		const auto& [index, isFoundInModDb] = it.value();
 
 		DbTypeEnum requestedType;
-		if(checkIfCorrectType<T>(index, isFoundInModDb, requestedType) && !checkIfErased(index, isFoundInModDb))
+		if(!checkIfCorrectType<T>(index, isFoundInModDb, requestedType))
 		{
-			return getEntryValues<T>(index, isFoundInModDb, requestedType);
+			rc.set(ReturnCodeRaw::TYPE_MISMATCH);
+			return {};
+		}
+		else if(checkIfErased(index, isFoundInModDb))
+		{
+			rc.set(ReturnCodeRaw::KEY_NOT_FOUND);
+			return {};
 		}
 
-		return {};
+		return getEntryValues<T>(index, isFoundInModDb);
 	}
 
 	template<typename T>
-	ReturnCodeEnum update(const std::string& key, std::vector<T>& values, bool isHardWrite)
+	ReturnCodeEnum readScalar(std::string_view key, T& value)
 	{
+		if constexpr(isScalarType<T>())
+		{
+			if(const DbEntry* entry = findScalarEntry(key); entry != nullptr)
+			{
+				if(entry->type != getDbType<T>()) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+				else if(const auto rc = readScalarSlot(*entry, value); rc.has_value()) return rc.value();
+			}
+		}
+
+		// Partial keys, 64-bit entries and entries which were updated to several values take the regular lookup
+		ReturnCodeEnum rc(ReturnCodeRaw::OK);
+		const std::vector<T> values = retrieveEntry<T>(std::string(key), rc);
+		if(rc.getRawEnum() != ReturnCodeRaw::OK) return rc;
+		else if(values.size() != 1) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+		value = values.front();
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum readScalarById(uint32_t id, T& value)
+	{
+		if constexpr(isScalarType<T>())
+		{
+			if(id < m_dbStorage.size() && m_dbStorage[id].scalar && m_dbStorage[id].type == getDbType<T>())
+			{
+				if(const auto rc = readScalarSlot(m_dbStorage[id], value); rc.has_value()) return rc.value();
+			}
+		}
+
+		T readValue {};
+		std::size_t count = 0;
+		const ReturnCodeEnum rc = copyEntryValuesById<T>(id, &readValue, 1, count);
+		if(rc.getRawEnum() == ReturnCodeRaw::BUFFER_TOO_SMALL || (rc.getRawEnum() == ReturnCodeRaw::OK && count != 1))
+		{
+			return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+		}
+		else if(rc.getRawEnum() == ReturnCodeRaw::OK) value = readValue;
+		return rc;
+	}
+
+	template<typename T>
+	ReturnCodeEnum writeScalar(std::string_view key, T value, bool isHardWrite)
+	{
+		if constexpr(isScalarType<T>())
+		{
+			// Only a key which already has its Modified DB entry is written in place, so that restore() and reset() still find it.
+			// Its first write, every hard write (ordered by the hard-save file) and erased keys take updateEntry() below.
+			if(!isHardWrite)
+			{
+				const auto rc = modifyScalarInPlace<T>(key, [value](T, T& newValue){
+					newValue = value;
+					return ReturnCodeEnum(ReturnCodeRaw::OK);
+				});
+				if(rc.has_value()) return rc.value();
+			}
+		}
+
+		std::vector<T> values {value};
+		return updateEntry<T>(std::string(key), values, isHardWrite);
+	}
+
+	// compute(current, next) returns OK to have next written, any other code is returned without writing.
+	// Same lock-free fast path as writeScalar(), everything else is read and written under one hold of m_modStorageMutex.
+	template<typename T, typename Compute>
+	ReturnCodeEnum modifyScalar(std::string_view key, Compute&& compute, bool isHardWrite)
+	{
+		if(!isHardWrite)
+		{
+			const auto rc = modifyScalarInPlace<T>(key, compute);
+			if(rc.has_value()) return rc.value();
+		}
+
+		return modifyEntry<T>(std::string(key), compute, isHardWrite);
+	}
+
+	// Lock-free write of the slot of an exact key which already has its Modified DB entry. std::nullopt if the locked path has
+	// to take over: the key has no such slot, another type or is read-only, or takeSnapshot() is copying the Modified DB.
+	template<typename T, typename Compute>
+	std::optional<ReturnCodeEnum> modifyScalarInPlace(std::string_view key, Compute&& compute)
+	{
+		if constexpr(isScalarType<T>())
+		{
+			const DbEntry* entry = findScalarEntry(key);
+			if(entry == nullptr || entry->type != getDbType<T>() || entry->permission.getRawEnum() != DbPermissionEnumRaw::PERM_READ_WRITE)
+			{
+				return std::nullopt;
+			}
+			else if(!beginLockFreeWrite()) return std::nullopt;
+
+			T next {};
+			const auto rc = modifySlot<T>(*entry->scalar, compute, next);
+			const bool isWritten = rc.has_value() && rc.value().getRawEnum() == ReturnCodeRaw::OK;
+			const uint64_t version = endLockFreeWrite(isWritten);
+			if(isWritten)
+			{
+				stampVersion(*entry, version);
+				notifyChange(entry->key, ChangeKind::UPDATED);
+			}
+			return rc;
+		}
+		else
+		{
+			(void)key;
+			(void)compute;
+			return std::nullopt;
+		}
+	}
+
+	template<typename T, typename Compute>
+	ReturnCodeEnum modifyEntry(const std::string& key, Compute& compute, bool isHardWrite)
+	{
+		auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
 		const auto& it = findMatchingIndices(key);
 		if(!it.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
 
-		const auto& [index, isFoundInModDb] = it.value();
+		auto [index, isFoundInModDb] = it.value();
 
 		if(!checkIfWritable(index, isFoundInModDb)) return ReturnCodeEnum(ReturnCodeRaw::NOT_WRITABLE);
 
 		DbTypeEnum requestedType;
 		if(!checkIfCorrectType<T>(index, isFoundInModDb, requestedType)) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+		std::size_t updatedIndex = 0;
+		{
+			auto lockStorage = m_stats.lock(m_modStorageMutex);
+			findModifiedCopy(index, isFoundInModDb);
+
+			DbEntry& entry = isFoundInModDb ? m_modDbStorage.at(index) : m_dbStorage.at(index);
+			if(isErased(entry)) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+			T next {};
+			bool isWritten = false;
+			if constexpr(isScalarType<T>())
+			{
+				// Soft writes of the slot do not take the lock, so its value can only be changed by compare-and-swap
+				if(isFoundInModDb && entry.scalar != nullptr)
+				{
+					if(const auto rc = modifySlot<T>(*entry.scalar, compute, next); rc.has_value())
+					{
+						if(rc.value().getRawEnum() != ReturnCodeRaw::OK) return rc.value();
+
+						// Keep the values in line for the hard-save file, they are not read as long as the slot is attached
+						if(isHardWrite) entry.values = std::make_shared<const DbValues>(DbValues {std::any(next)});
+						commitChange(entry, ChangeKind::UPDATED);
+						updatedIndex = index;
+						isWritten = true;
+					}
+				}
+			}
+
+			if(!isWritten)
+			{
+				std::vector<T> values;
+				appendEntryValues<T>(entry, values);
+				if(values.size() != 1) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+				if(const auto rc = compute(values.front(), next); rc.getRawEnum() != ReturnCodeRaw::OK) return rc;
+
+				values.front() = next;
+				updatedIndex = updateLockedDbEntry<T>(index, isFoundInModDb, values);
+			}
+		}
+
+		// Note that: updateHardSavedDb() rewrites the file without holding m_modStorageMutex
+		if(isHardWrite) updateHardSavedDb(updatedIndex);
+
+		return ReturnCodeEnum(ReturnCodeRaw::OK);
+	}
+
+	template<typename T>
+	ReturnCodeEnum copySnapshotValues(const Snapshot& snapshot, const std::string& key, std::vector<T>& values)
+	{
+		const DbEntry* entry = findSnapshotEntry(snapshot, key);
+		if(entry == nullptr) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+		else if(entry->type.getRawEnum() != getDbType<T>())
+		{
+			DB_TRACE(TRACE_ABN, "Requested type ", DbTypeEnum(getDbType<T>()).toString(), " did not match with DB entry type ", entry->type.toString());
+			return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+		}
+		else if(ErasedBitmap::test(snapshot.erasedWords, entry->id)) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+		// Never the slot of an Original DB entry, it may already hold a value written after the snapshot
+		values.clear();
+		appendStoredValues<T>(*entry, values);
+		return ReturnCodeEnum(ReturnCodeRaw::OK);
+	}
+
+	template<typename T>
+	ReturnCodeEnum copyChangedValues(const std::string& key, uint64_t sinceVersion, std::vector<T>& values, uint64_t& entryVersion)
+	{
+		auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
+		const auto& it = findMatchingIndices(key, true);
+		if(!it.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+		const auto& [index, isFoundInModDb] = it.value();
+
+		DbTypeEnum requestedType;
+		if(!checkIfCorrectType<T>(index, isFoundInModDb, requestedType)) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+		// Writers store the values before the stamp and the stamp is loaded before the values here,
+		// so the values read below are never older than entryVersion
+		entryVersion = getEntryVersion(index, isFoundInModDb);
+		if(entryVersion <= sinceVersion) return ReturnCodeEnum(ReturnCodeRaw::UNCHANGED);
 		else if(checkIfErased(index, isFoundInModDb)) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
 
-		auto updatedIndex = updateDbEntry<T>(index, isFoundInModDb, values, requestedType);
+		values = getEntryValues<T>(index, isFoundInModDb);
+		return ReturnCodeEnum(ReturnCodeRaw::OK);
+	}
+
+	template<typename T>
+	ReturnCodeEnum copyEntryValues(std::string_view key, T* values, std::size_t capacity, std::size_t& count)
+	{
+		count = 0;
+
+		auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
+		bool isFoundInModDb = true;
+		std::optional<std::size_t> index;
+		{
+			auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+			if(const auto wholeKey = findWholeKey(key, m_modKeyIndex); wholeKey.has_value())
+			{
+				index = wholeKey->first;
+				isFoundInModDb = wholeKey->second;
+			}
+			else index = findFirstMatchingKey(key, m_modDbDictionary);
+		}
+		if(!index.has_value())
+		{
+			isFoundInModDb = false;
+			if(mayBeFound(key))
+			{
+				auto lockDictionary = m_stats.lockShared(m_dictionaryMutex);
+				index = findFirstMatchingKey(key, m_dbDictionary);
+				if(!index.has_value()) m_stats.count(DbStats::Counter::FILTER_FALSE_POSITIVES);
+			}
+		}
+		if(!index.has_value())
+		{
+			auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+			const auto fallback = findPrefixFallback(key, m_modKeyIndex);
+			if(!fallback.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+			index = fallback->first;
+			isFoundInModDb = fallback->second;
+		}
+		m_stats.count(isFoundInModDb ? DbStats::Counter::MODIFIED_DB_HITS : DbStats::Counter::ORIGINAL_DB_HITS);
+
+		std::shared_mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
+		const DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
+
+		auto lockStorage = m_stats.lockShared(mtx);
+		const DbEntry& entry = dbStorage[index.value()];
+		if(entry.type != getDbType<T>()) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+		else if(isErased(entry)) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+		return copyValues<T>(entry, values, capacity, count);
+	}
+
+	// The Original DB is never written after load, so an entry whose values are still the original ones is read without lock.
+	// Any other one may have a Modified DB copy and takes the lookup of its exact key.
+	template<typename T>
+	ReturnCodeEnum copyEntryValuesById(uint32_t id, T* values, std::size_t capacity, std::size_t& count)
+	{
+		count = 0;
+
+		// Ids of keys which exist in swdb-hardsave.bin only are not part of any generated accessor
+		if(id >= m_dbStorage.size()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+		const DbEntry& entry = m_dbStorage[id];
+		if(!isOriginalCurrent(entry)) return copyEntryValues<T>(entry.key, values, capacity, count);
+		else if(entry.type != getDbType<T>()) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+		m_stats.count(DbStats::Counter::ORIGINAL_DB_HITS);
+		return copyValues<T>(entry, values, capacity, count);
+	}
+
+	// Same result as retrieveEntry(), all four DB locks must be held by the caller
+	template<typename T>
+	ReturnCodeEnum retrieveLockedEntry(const std::string& key, std::vector<T>& values)
+	{
+		values.clear();
+
+		std::optional<std::pair<std::size_t, bool>> found = findWholeKey(key, m_modKeyIndex);
+		if(!found.has_value())
+		{
+			if(const auto index = findFirstMatchingKey(key, m_modDbDictionary); index.has_value()) found = std::make_pair(index.value(), true);
+		}
+		if(!found.has_value() && mayBeFound(key))
+		{
+			if(const auto index = findFirstMatchingKey(key, m_dbDictionary); index.has_value()) found = std::make_pair(index.value(), false);
+			else m_stats.count(DbStats::Counter::FILTER_FALSE_POSITIVES);
+		}
+		if(!found.has_value()) found = findPrefixFallback(key, m_modKeyIndex);
+		if(!found.has_value())
+		{
+			DB_TRACE(TRACE_ABN, "DB key ", key, " could not be found even in Original DB!");
+			m_stats.count(DbStats::Counter::KEY_NOT_FOUND);
+			return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+		}
+		m_stats.count(found->second ? DbStats::Counter::MODIFIED_DB_HITS : DbStats::Counter::ORIGINAL_DB_HITS);
+
+		const DbEntry& entry = (found->second ? m_modDbStorage : m_dbStorage)[found->first];
+		if(entry.type != getDbType<T>())
+		{
+			DB_TRACE(TRACE_ABN, "Requested type ", DbTypeEnum(getDbType<T>()).toString(), " did not match with DB entry type ", entry.type.toString());
+			m_stats.count(DbStats::Counter::TYPE_MISMATCH);
+			return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+		}
+		else if(isErased(entry))
+		{
+			DB_TRACE(TRACE_ABN, "DB key ", entry.key, " was already erased!");
+			m_stats.count(DbStats::Counter::KEY_NOT_FOUND);
+			return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+		}
+
+		appendEntryValues<T>(entry, values);
+		return ReturnCodeEnum(ReturnCodeRaw::OK);
+	}
+
+	template<typename T>
+	ReturnCodeEnum updateEntry(const std::string& key, std::vector<T>& values, bool isHardWrite)
+	{
+		auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
+		const auto& it = findMatchingIndices(key);
+		if(!it.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+
+		const auto& [index, isFoundInModDb] = it.value();
+
+		if(!checkIfWritable(index, isFoundInModDb)) return ReturnCodeEnum(ReturnCodeRaw::NOT_WRITABLE);
+
+		DbTypeEnum requestedType;
+		if(!checkIfCorrectType<T>(index, isFoundInModDb, requestedType)) return ReturnCodeEnum(ReturnCodeRaw::TYPE_MISMATCH);
+
+		const auto updatedIndex = updateDbEntry<T>(index, isFoundInModDb, values);
+		if(!updatedIndex.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
 
 		if(isHardWrite)
 		{
 			// Edit and overwrite swdb-hardsave.bin file with new entry's value to keep it persistent over restarts.
 			// Note that: updateDbEntry() must be called before updateHardSavedDb()
-			updateHardSavedDb(updatedIndex);
+			updateHardSavedDb(updatedIndex.value());
 		}
 
 		return ReturnCodeEnum(ReturnCodeRaw::OK);
 	}
-	
-	ReturnCodeEnum restore(const std::string& key);
-	ReturnCodeEnum resetToDefault();
-	ReturnCodeEnum erase(const std::string& key);
 
-private:
 	explicit DbLoader();
-	virtual ~DbLoader() = default;
-	
-	struct EntryStatus
+	virtual ~DbLoader();
+
+	using DbValues = std::vector<std::any>;
+
+	// Current value of an Original DB entry with a single value of up to 32 bits, shared with its copy in the Modified DB.
+	// The state bits live in the same word as the value, so readers see both with one atomic load and never take a lock.
+	// Everything but the in-place soft write of writeScalar() changes the word under m_modStorageMutex.
+	struct ScalarSlot
 	{
-		bool isErased {false};
+		static constexpr uint64_t IS_MODIFIED = uint64_t {1} << 32; // The key has an entry in the Modified DB
+		static constexpr uint64_t IS_ERASED = uint64_t {1} << 33;
+		static constexpr uint64_t IS_DETACHED = uint64_t {1} << 34; // The Modified DB entry has not a single value, read it instead
+		static constexpr uint64_t STATE_MASK = IS_MODIFIED | IS_ERASED | IS_DETACHED;
+
+		std::atomic<uint64_t> word {0};
+		uint32_t originalValue {0};
 	};
 
 	struct DbEntry
 	{
-		std::string key;
+		std::string_view key; // Interned in the arena of the DB which loaded the entry
 		DbPermissionEnum permission;
 		DbTypeEnum type;
-		std::vector<std::any> values;
+		std::shared_ptr<const DbValues> values; // Shared by all entries with identical type and value, never modified in place (copy-on-write)
+		ScalarSlot* scalar {nullptr}; // Authoritative value unless IS_DETACHED, values may be stale after in-place soft writes
+		std::atomic<uint64_t>* version {nullptr}; // DB version of its last change (0 if never), shared with its copy in the Modified DB
+		uint32_t id {0}; // Position in the Original DB, kept by its copy in the Modified DB. Hard-saved keys missing in it are numbered after it
+	};
 
-		EntryStatus status;
+	// CHAR values of the Modified DB: the sub-strings and the whole string are views into text, which lives as long as the values.
+	// Unlike strings interned into an arena, the string of a value is freed once no entry nor snapshot refers to it anymore.
+	struct OwnedStringValues
+	{
+		std::string text;
+		DbValues values;
 	};
 
 	using DatabaseStorage = std::vector<DbEntry>;
-	using DatabaseDictionary = std::unordered_map<std::string, std::unordered_set<std::size_t>>;
+	// Sub-keys are views into the interned keys, so looking up a token never allocates
+	using DatabaseDictionary = std::unordered_map<std::string_view, std::unordered_set<std::size_t>>;
+
+	// Whole keys of the Modified DB are resolved by id rather than by their sub-keys, see findWholeKey()
+	struct ModifiedKeyIndex
+	{
+		using IndexById = std::unordered_map<uint32_t, std::size_t>;
+		using HardSavedOnlyIds = std::unordered_map<std::string_view, uint32_t>;
+
+		IndexById indexById; // Modified DB index of the copy of each entry id
+		HardSavedOnlyIds hardSavedOnlyIds; // Keys replayed from swdb-hardsave.bin which are not in the Original DB
+	};
+
+public:
+	// Copy of the Modified DB at one version, the Original DB is never modified so snapshots read it in place, see takeSnapshot()
+	struct Snapshot
+	{
+		uint64_t version {0};
+		DatabaseStorage modDbStorage; // Slot values are copied into values, the copies have no slot
+		DatabaseDictionary modDbDictionary;
+		ModifiedKeyIndex modKeyIndex;
+		std::vector<uint64_t> erasedWords; // Copy of the erased bitmap, see ErasedBitmap::test(words, id)
+		mutable std::shared_mutex dictionaryMutex; // Only for findMatchingKeys(), snapshots are immutable
+	};
+
+private:
+
+	// Readers take the shared side of the storage and dictionary locks, writers the exclusive one.
+	// Lock order: m_modLayoutMutex, m_hardSaveMutex, m_modStorageMutex, m_storageMutex, m_modDictionaryMutex, m_dictionaryMutex.
+	// m_pendingHardSaveMutex is only held to queue or take file work and nests inside any of them.
 
 	// Original Database
-	std::mutex m_storageMutex;
+	std::shared_mutex m_storageMutex;
+	StringArena m_dbArena; // Owns all keys (unless they point into an embedded image) and CHAR values of m_dbStorage, guarded by m_storageMutex
 	DatabaseStorage m_dbStorage;
-	std::mutex m_dictionaryMutex;
+	std::shared_mutex m_dictionaryMutex;
 	DatabaseDictionary m_dbDictionary;
+	KeyIndex m_keyIndex; // Whole keys of m_dbStorage, only written at load so it is read without lock
+	std::unique_ptr<ScalarSlot[]> m_scalarSlots; // One per single-value entry of up to 32 bits, allocated at load
+	std::size_t m_numberOfScalarSlots {0};
+	BloomFilter m_tokenFilter; // Sub-keys of m_dbDictionary, only written at load so it is read without lock
+	std::unique_ptr<std::atomic<uint64_t>[]> m_entryVersions; // One per entry, allocated at load
 
 	// Modified Database (prefer searching in this database first, if not found then try on Original Database)
-	std::mutex m_modStorageMutex;
+	// Operations look an index up and use it under later holds of the other locks, so they keep m_modLayoutMutex shared in between.
+	// restore() and reset() move or drop Modified DB entries, which only happens with it held exclusively.
+	std::shared_mutex m_modLayoutMutex;
+	std::shared_mutex m_modStorageMutex;
+	StringArena m_modDbArena; // Owns the keys of the entries replayed from swdb-hardsave.bin, guarded by m_modStorageMutex
 	DatabaseStorage m_modDbStorage;
-	std::mutex m_modDictionaryMutex;
+	std::shared_mutex m_modDictionaryMutex;
 	DatabaseDictionary m_modDbDictionary;
-
-	bool isHardSavedDbFileInit {false};
-	const std::string m_binDbPath { "/home/giangnguyentbk/workspace/dbengine/sw/texttobin/swdb" }; // currently hardcoded
+	ModifiedKeyIndex m_modKeyIndex; // Guarded by m_modDictionaryMutex, like m_modDbDictionary
+	std::vector<uint32_t> m_hardSavedIds; // Sorted ids of the Original DB entries replayed from swdb-hardsave.bin, never changed after load
+	ErasedBitmap m_erasedEntries; // Erase state of every entry by its id, set and cleared under m_modStorageMutex but tested without lock
+	uint32_t m_numberOfHardSavedOnlyIds {0}; // Ids given to hard-saved keys which are not in the Original DB, only written at load
+
+	static constexpr char DB_REVISION_INLINE_VALUES = 10; // Each entry carries its own "value"
+	static constexpr char DB_REVISION_VALUE_POOL = 11; // Each entry carries an offset into a value pool placed after all entries
+
+	DbStats m_stats;
+	LoadStats m_loadStats; // Only written by the constructor
+	HotKeyTracker m_hotKeys;
+	// The bits from VERSION_SHIFT up count the writes so far, which is the DB version. The bits below count the lock-free writers
+	// inside modifyScalarInPlace(), which takeSnapshot() waits for. Locked writers are kept out of snapshots by m_modStorageMutex.
+	static constexpr unsigned VERSION_SHIFT = 16;
+	static constexpr uint64_t VERSION_INCREMENT = uint64_t {1} << VERSION_SHIFT;
+	std::atomic<uint64_t> m_writeSequence {0};
+	std::atomic<bool> m_isSnapshotPending {false};
+	std::atomic<std::size_t> m_numberOfSnapshots {0}; // Alive snapshots, which may still point into m_modDbArena
+
+	ReadCache m_readCache;
+	ChangeNotifier m_notifier; // Declared after the DBs, so its thread is stopped before they are destroyed
+
+	std::thread m_warmUpThread; // Only running shortly after load, see startWarmUp()
+	std::atomic<bool> m_isWarmUpStopped {false};
+
+	std::mutex m_hardSaveMutex; // Serializes rewrites of swdb-hardsave.bin, taken before any storage lock
+	bool isHardSavedDbFileInit {false}; // Guarded by m_hardSaveMutex
+	// File work of restore() and reset(), queued with m_modLayoutMutex held exclusively so that it stays ordered with the hard writes,
+	// then done under m_hardSaveMutex alone so that readers do not wait for it, see applyPendingHardSave()
+	std::mutex m_pendingHardSaveMutex;
+	bool m_isHardSaveResetPending {false}; // Guarded by m_pendingHardSaveMutex
+	std::vector<std::string> m_pendingRestoredKeys; // Guarded by m_pendingHardSaveMutex
+	const std::string m_binDbPath; // Directory of swdb.bin and swdb-hardsave.bin, see getBinDbPath()
 	uint32_t m_crc16Table[256] = 
 	{
 		0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
@@ -264,41 +881,281 @@ private:
 	};
 
 private:
+	static std::string getBinDbPath();
+	static std::optional<std::string_view> getEmbeddedDbImage();
 	bool loadDb(const std::string& binFilePath);
+	bool loadDbImage(std::string_view image, bool isStatic);
 	bool loadHardSavedDb(const std::string& binFilePath);
-	std::vector<std::string> tokenize(const std::string& key, const std::string& delimiter);
-	std::vector<std::size_t> findMatchingKeys(const std::string& input, const DatabaseDictionary& dbDictionary, std::mutex& mtx);
+	void traceLoadStats();
+	void recordHotKey(const std::string& key, const ReturnCodeEnum& rc, HotKeyTracker::Access access);
+	void startWarmUp();
+	void warmUp(const std::string& manifestPath, uint64_t budgetNs, bool isLocked);
+	bool warmUpEntry(std::string_view key, bool& isLocked);
+	void addMemoryUsage(const DatabaseStorage& dbStorage, const DatabaseDictionary& dbDictionary, const StringArena& arena, uint32_t prefixDepth,
+		std::unordered_set<const DbValues*>& countedValues, MemoryUsage::Db& usage, std::map<std::string, MemoryUsage::Part>& perPrefix);
+	static uint64_t getValuesBytes(const DbTypeEnum& type, const DbValues& values, bool isOwningStrings);
+	static std::shared_ptr<const DbValues> makeOwnedStringValues(const std::vector<std::string_view>& subStrings, std::string_view wholeString);
+	bool parseDbEntries(std::string_view entries, std::string_view valuePool, bool hasValuePool, bool isStatic);
+	bool parsePermission(char c, DbPermissionEnum& permission);
+	bool parseType(char c, DbTypeEnum& type);
+	bool parseValues(const DbTypeEnum& type, std::string_view valueStr, StringArena& arena, DbValues& values);
+	std::vector<std::string_view> tokenize(std::string_view str, char delimiter);
+	void addToDictionary(std::string_view key, std::size_t index, DatabaseDictionary& dbDictionary);
+	std::vector<std::size_t> findMatchingKeys(std::string_view input, const DatabaseDictionary& dbDictionary, std::shared_mutex& mtx);
 	bool isFitIntegralType(const int64_t& valueToCheck, const DbTypeEnum& type);
-	std::optional<std::pair<std::size_t, bool>> findMatchingIndices(const std::string& input);
+	std::optional<std::pair<std::size_t, bool>> findMatchingIndices(std::string_view input, bool isPrefixFallback = false);
+	std::optional<std::pair<std::size_t, bool>> findWholeKey(std::string_view key, const ModifiedKeyIndex& modKeyIndex) const;
+	std::optional<std::pair<std::size_t, bool>> findPrefixFallback(std::string_view key, const ModifiedKeyIndex& modKeyIndex) const;
+	std::optional<std::size_t> findFirstMatchingKey(std::string_view input, const DatabaseDictionary& dbDictionary) const;
+	bool mayBeFound(std::string_view key);
 	bool checkIfWritable(const std::size_t& index, const bool& isFoundInModDb);
 	bool checkIfErased(const std::size_t& index, const bool& isFoundInModDb);
+	std::size_t restoreErasedEntries(std::string_view key);
 	void updateHardSavedDb(const std::size_t& index);
 	void initHardSavedDbFile();
 	uint16_t getCRC16(uint8_t *startAddr, uint32_t numberBytes);
+	uint64_t getContentHash(const uint8_t *startAddr, uint32_t numberBytes);
 	uint32_t lookupCRC16Table(uint32_t initCRC, uint8_t data);
-	std::size_t eraseDbEntry(const std::size_t& index, const bool& isFoundInModDb);
-	void restoreHardSavedDb(const std::size_t& index);
+	void applyPendingHardSave();
+	void restoreHardSavedDb(const std::unordered_set<std::string>& restoredKeys);
+	ReturnCodeEnum restoreEntries(const std::string& key);
+	ReturnCodeEnum resetModifiedDb();
+	ReturnCodeEnum eraseEntry(const std::string& key);
+
+	// Call visitor(token) for every non-empty token of str, spaces and tabs around a token are trimmed.
+	// Stop early and return false as soon as visitor returns false. Nothing is allocated.
+	template<typename Visitor>
+	static bool forEachToken(std::string_view str, char delimiter, Visitor&& visitor)
+	{
+		std::size_t startIndex = 0;
+		while(startIndex <= str.length())
+		{
+			std::size_t i = str.find(delimiter, startIndex);
+			if(i == std::string_view::npos) i = str.length();
+
+			std::string_view token = str.substr(startIndex, i - startIndex);
+			const auto first = token.find_first_not_of(" \t");
+			if(first != std::string_view::npos)
+			{
+				token = token.substr(first, token.find_last_not_of(" \t") - first + 1);
+				if(!visitor(token)) return false;
+			}
+
+			startIndex = i + 1;
+		}
+
+		return true;
+	}
+
+	// Types whose single-value entries get a ScalarSlot, 64-bit values would not leave room for the state bits
+	template<typename T>
+	static constexpr bool isScalarType()
+	{
+		return std::is_integral<T>::value && !std::is_same<T, char>::value && sizeof(T) <= sizeof(uint32_t);
+	}
+
+	bool isErased(const DbEntry& entry) const
+	{
+		return m_erasedEntries.test(entry.id);
+	}
+
+	// True if entry of the Original DB was neither changed since load (its stamp is 0) nor replaced by swdb-hardsave.bin.
+	// A change racing with it is ordered after the read, the values of the Original DB stay valid anyway.
+	bool isOriginalCurrent(const DbEntry& entry) const
+	{
+		return entry.version->load(std::memory_order_acquire) == 0
+			&& !std::binary_search(m_hardSavedIds.begin(), m_hardSavedIds.end(), entry.id);
+	}
+
+	// The Original DB entry of exact key if it has a slot, found without lock
+	const DbEntry* findScalarEntry(std::string_view key) const
+	{
+		const auto index = m_keyIndex.find(key);
+		return index.has_value() && m_dbStorage[index.value()].scalar ? &m_dbStorage[index.value()] : nullptr;
+	}
+
+	// Value of the slot of entry, std::nullopt if it has none or it is detached
+	static std::optional<uint32_t> loadScalar(const DbEntry& entry)
+	{
+		if(entry.scalar == nullptr) return std::nullopt;
+
+		const uint64_t word = entry.scalar->word.load(std::memory_order_relaxed);
+		return (word & ScalarSlot::IS_DETACHED) ? std::nullopt : std::optional<uint32_t>(static_cast<uint32_t>(word));
+	}
+
+	// One atomic load of the slot of an Original DB entry of type T, std::nullopt if the slot is detached
+	template<typename T>
+	static std::optional<ReturnCodeEnum> readScalarSlot(const DbEntry& entry, T& value)
+	{
+		const uint64_t word = entry.scalar->word.load(std::memory_order_relaxed);
+		if(word & ScalarSlot::IS_ERASED) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+		else if(word & ScalarSlot::IS_DETACHED) return std::nullopt;
+
+		value = static_cast<T>(static_cast<uint32_t>(word));
+		return ReturnCodeEnum(ReturnCodeRaw::OK);
+	}
+
+	// Copy the values of an entry of type T, its storage lock must be held unless it is an Original DB entry
+	template<typename T>
+	static ReturnCodeEnum copyValues(const DbEntry& entry, T* values, std::size_t capacity, std::size_t& count)
+	{
+		const DbValues& dbValues = *entry.values;
+		if constexpr(isScalarType<T>())
+		{
+			if(const auto scalar = loadScalar(entry); scalar.has_value())
+			{
+				count = 1;
+				if(capacity == 0) return ReturnCodeEnum(ReturnCodeRaw::BUFFER_TOO_SMALL);
+
+				values[0] = static_cast<T>(scalar.value());
+				return ReturnCodeEnum(ReturnCodeRaw::OK);
+			}
+		}
+
+		if constexpr(std::is_same<T, char>::value)
+		{
+			// The whole string is stored after its sub-strings
+			const auto* str = dbValues.empty() ? nullptr : std::any_cast<std::string_view>(&dbValues.back());
+			count = str ? str->size() : 0;
+			if(capacity == 0) return ReturnCodeEnum(ReturnCodeRaw::BUFFER_TOO_SMALL);
+
+			const std::size_t length = std::min(count, capacity - 1);
+			if(length) std::memcpy(values, str->data(), length);
+			values[length] = '\0';
+			return ReturnCodeEnum(count < capacity ? ReturnCodeRaw::OK : ReturnCodeRaw::BUFFER_TOO_SMALL);
+		}
+		else
+		{
+			count = dbValues.size();
+			const std::size_t numberOfCopies = std::min(count, capacity);
+			for(std::size_t i = 0; i < numberOfCopies; ++i)
+			{
+				const T* v = std::any_cast<T>(&dbValues[i]);
+				values[i] = v ? *v : T();
+			}
+			return ReturnCodeEnum(count <= capacity ? ReturnCodeRaw::OK : ReturnCodeRaw::BUFFER_TOO_SMALL);
+		}
+	}
+
+	// Mirror values just written into the Modified DB entry, m_modStorageMutex must be held
+	template<typename T>
+	static void storeScalar(const DbEntry& entry, const std::vector<T>& values)
+	{
+		if constexpr(isScalarType<T>())
+		{
+			if(entry.scalar == nullptr) return;
+
+			const uint64_t word = values.size() == 1 ? static_cast<uint32_t>(values.front()) : ScalarSlot::IS_DETACHED;
+			entry.scalar->word.store(ScalarSlot::IS_MODIFIED | word, std::memory_order_relaxed);
+		}
+	}
+
+	// Compare-and-swap compute(current, next) into the slot of a key which has its Modified DB entry.
+	// std::nullopt as soon as the slot is in any other state, the caller then has to take the locked path.
+	template<typename T, typename Compute>
+	static std::optional<ReturnCodeEnum> modifySlot(ScalarSlot& slot, Compute&& compute, T& next)
+	{
+		uint64_t word = slot.word.load(std::memory_order_relaxed);
+		while((word & ScalarSlot::STATE_MASK) == ScalarSlot::IS_MODIFIED)
+		{
+			if(const auto rc = compute(static_cast<T>(static_cast<uint32_t>(word)), next); rc.getRawEnum() != ReturnCodeRaw::OK) return rc;
+
+			if(slot.word.compare_exchange_weak(word, ScalarSlot::IS_MODIFIED | static_cast<uint32_t>(next), std::memory_order_relaxed))
+			{
+				return ReturnCodeEnum(ReturnCodeRaw::OK);
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	// Queue a change for the subscribers, free if there is none
+	void notifyChange(std::string_view key, ChangeKind kind)
+	{
+		if(m_notifier.hasSubscriptions()) m_notifier.publish(key, kind);
+	}
+
+	// Record a change made under m_modStorageMutex
+	void commitChange(const DbEntry& entry, ChangeKind kind)
+	{
+		stampVersion(entry, advanceVersion());
+		notifyChange(entry.key, kind);
+	}
+
+	// m_modStorageMutex must be held, returns the new DB version
+	uint64_t advanceVersion()
+	{
+		return (m_writeSequence.fetch_add(VERSION_INCREMENT, std::memory_order_acq_rel) >> VERSION_SHIFT) + 1;
+	}
+
+	// False if a snapshot is being taken, the writer then has to take the locked path
+	bool beginLockFreeWrite()
+	{
+		m_writeSequence.fetch_add(1, std::memory_order_seq_cst);
+		if(!m_isSnapshotPending.load(std::memory_order_seq_cst)) return true;
+
+		m_writeSequence.fetch_sub(1, std::memory_order_release);
+		return false;
+	}
+
+	// Returns the new DB version if isWritten
+	uint64_t endLockFreeWrite(bool isWritten)
+	{
+		if(!isWritten)
+		{
+			m_writeSequence.fetch_sub(1, std::memory_order_release);
+			return 0;
+		}
+
+		return (m_writeSequence.fetch_add(VERSION_INCREMENT - 1, std::memory_order_acq_rel) >> VERSION_SHIFT) + 1;
+	}
+
+	// Stamps only move forward, lock-free writers of the same entry may finish out of order
+	static void stampVersion(const DbEntry& entry, uint64_t version)
+	{
+		if(entry.version == nullptr) return;
+
+		uint64_t stamp = entry.version->load(std::memory_order_relaxed);
+		while(stamp < version && !entry.version->compare_exchange_weak(stamp, version, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	uint64_t getEntryVersion(const std::size_t& index, const bool& isFoundInModDb);
+	void findModifiedCopy(std::size_t& index, bool& isFoundInModDb);
+	const DbEntry* findSnapshotEntry(const Snapshot& snapshot, std::string_view key);
+
+	static std::optional<uint32_t> getScalarValue(const DbEntry& entry);
+	static std::any makeScalarValue(const DbTypeEnum& type, uint32_t value);
+	void attachScalarSlots();
+
+	template<typename T>
+	static constexpr DbTypeEnumRaw getDbType()
+	{
+		if constexpr(std::is_same<T, uint8_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_U8;
+		else if constexpr(std::is_same<T, int8_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_S8;
+		else if constexpr(std::is_same<T, uint16_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_U16;
+		else if constexpr(std::is_same<T, int16_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_S16;
+		else if constexpr(std::is_same<T, uint32_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_U32;
+		else if constexpr(std::is_same<T, int32_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_S32;
+		else if constexpr(std::is_same<T, uint64_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_U64;
+		else if constexpr(std::is_same<T, int64_t>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_S64;
+		else if constexpr(std::is_same<T, std::string>::value || std::is_same<T, char>::value) return DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR;
+		else return DbTypeEnumRaw::TYPE_OF_ENTRY_UNDEFINED;
+	}
 
 	template<typename T>
 	bool checkIfCorrectType(const std::size_t& index, const bool& isFoundInModDb, DbTypeEnum& requestedType)
 	{
 		DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
-		std::mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
-
-		if(std::is_same<T, uint8_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U8);
-		else if(std::is_same<T, int8_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S8);
-		else if(std::is_same<T, uint16_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U16);
-		else if(std::is_same<T, int16_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S16);
-		else if(std::is_same<T, uint32_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U32);
-		else if(std::is_same<T, int32_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S32);
-		else if(std::is_same<T, uint64_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U64);
-		else if(std::is_same<T, int64_t>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S64);
-		else if(std::is_same<T, std::string>::value) requestedType.set(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR);
-
-		std::scoped_lock<std::mutex> lockStorage(mtx);
+		std::shared_mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
+
+		requestedType.set(getDbType<T>());
+
+		auto lockStorage = m_stats.lockShared(mtx);
 		if(dbStorage.at(index).type != requestedType)
 		{
-			TPT_TRACE(TRACE_ABN, SSTR("Requested type ", requestedType.toString(), " did not match with DB entry type ", dbStorage.at(index).type.toString()));
+			DB_TRACE(TRACE_ABN, "Requested type ", requestedType.toString(), " did not match with DB entry type ", dbStorage.at(index).type.toString());
 			return false;
 		}
 
@@ -306,25 +1163,55 @@ private:
 	}
 
 	template<typename T>
-	std::vector<T> getEntryValues(const std::size_t& index, const bool& isFoundInModDb, const DbTypeEnum& requestedType)
+	std::vector<T> getEntryValues(const std::size_t& index, const bool& isFoundInModDb)
 	{
-		std::mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
+		std::shared_mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
 		DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
 
 		std::vector<T> values;
 		values.reserve(64); // Currently hardcoded
-		std::scoped_lock<std::mutex> lockStorage(mtx);
-		for(const std::any& v : dbStorage.at(index).values)
+		auto lockStorage = m_stats.lockShared(mtx);
+		appendEntryValues<T>(dbStorage.at(index), values);
+		return values;
+	}
+
+	template<typename T>
+	void appendEntryValues(const DbEntry& entry, std::vector<T>& values)
+	{
+		if constexpr(isScalarType<T>())
+		{
+			if(const auto scalar = loadScalar(entry); scalar.has_value())
+			{
+				values.emplace_back(static_cast<T>(scalar.value()));
+				return;
+			}
+		}
+
+		appendStoredValues<T>(entry, values);
+	}
+
+	template<typename T>
+	void appendStoredValues(const DbEntry& entry, std::vector<T>& values)
+	{
+		for(const std::any& v : *entry.values)
 		{
 			if(v.has_value())
 			{
 				try
 				{
-					values.emplace_back(std::any_cast<T>(v));
+					if constexpr(std::is_same<T, std::string>::value)
+					{
+						// CHAR values are kept as views into the DB arena
+						values.emplace_back(std::any_cast<std::string_view>(v));
+					}
+					else
+					{
+						values.emplace_back(std::any_cast<T>(v));
+					}
 				}
 				catch(const std::exception& e)
 				{
-					TPT_TRACE(TRACE_ABN, SSTR("Could not any_cast DB entry for key ", dbStorage.at(index).key, " to type ", requestedType.toString()));
+					DB_TRACE(TRACE_ABN, "Could not any_cast DB entry for key ", entry.key, " to type ", entry.type.toString());
 				}
 			}
 			else
@@ -332,78 +1219,72 @@ private:
 				values.emplace_back(T());
 			}
 		}
+	}
 
-		return values;
+	// std::nullopt if the entry is erased, which is only checked under the lock so that no erase() can come in before the write
+	template<typename T>
+	std::optional<std::size_t> updateDbEntry(std::size_t index, bool isFoundInModDb, std::vector<T>& values)
+	{
+		auto lockStorage = m_stats.lock(m_modStorageMutex);
+		findModifiedCopy(index, isFoundInModDb);
+		if(isErased(isFoundInModDb ? m_modDbStorage.at(index) : m_dbStorage.at(index))) return std::nullopt;
+
+		return updateLockedDbEntry<T>(index, isFoundInModDb, values);
 	}
 
+	// Same as updateDbEntry(), m_modStorageMutex must be held and findModifiedCopy() called under it
 	template<typename T>
-	std::size_t updateDbEntry(const std::size_t& index, const bool& isFoundInModDb, std::vector<T>& values, const DbTypeEnum& requestedType)
+	std::size_t updateLockedDbEntry(const std::size_t& index, const bool& isFoundInModDb, std::vector<T>& values)
 	{
-		std::scoped_lock<std::mutex> lockStorage(m_modStorageMutex);
-		if(isFoundInModDb)
+		// Values may be shared with other entries, so always build a new copy instead of modifying them in place
+		std::shared_ptr<const DbValues> newValues;
+		if constexpr(std::is_same<T, std::string>::value)
 		{
-			// Modify value in the found entry in Modified DB
-			m_modDbStorage.at(index).values.clear();
-			if(requestedType.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
+			std::string concatStr;
+			for(const auto& v : values)
 			{
-				std::string concatStr;
-				for(const auto& v : values)
-				{
-					concatStr += (v + " "); // Try to make it as much similar as with a complete string "value" with at least 1 space between each substring
-					m_modDbStorage.at(index).values.emplace_back(v);
-				}
-
-				concatStr.pop_back(); // Remove the last redundant space " "
-				m_modDbStorage.at(index).values.emplace_back(concatStr);
+				concatStr += (v + " "); // Try to make it as much similar as with a complete string "value" with at least 1 space between each substring
 			}
-			else
+
+			if(!concatStr.empty()) concatStr.pop_back(); // Remove the last redundant space " "
+			newValues = makeOwnedStringValues(std::vector<std::string_view>(values.begin(), values.end()), concatStr);
+		}
+		else
+		{
+			DbValues parsedValues;
+			for(const auto& v : values)
 			{
-				for(const auto& v : values)
-				{
-					m_modDbStorage.at(index).values.emplace_back(v);
-				}
+				parsedValues.emplace_back(v);
 			}
+			newValues = std::make_shared<const DbValues>(std::move(parsedValues));
+		}
 
-			TPT_TRACE(TRACE_INFO, SSTR("Modified entry ", m_modDbStorage.at(index).key, " in Modified DB successfully!"));
+		if(isFoundInModDb)
+		{
+			// Modify value in the found entry in Modified DB
+			m_modDbStorage.at(index).values = std::move(newValues);
+			storeScalar(m_modDbStorage.at(index), values);
+			commitChange(m_modDbStorage.at(index), ChangeKind::UPDATED);
+
+			DB_TRACE(TRACE_INFO, "Modified entry ", m_modDbStorage.at(index).key, " in Modified DB successfully!");
 			return index;
 		}
 		else
 		{
 			// Add new entry with updated value into Modified DB. Do not change anything in Original DB
-			std::scoped_lock<std::mutex> lockStorage(m_storageMutex);
-			std::scoped_lock<std::mutex> lockDictionary(m_modDictionaryMutex);
+			auto lockStorage = m_stats.lockShared(m_storageMutex);
+			auto lockDictionary = m_stats.lock(m_modDictionaryMutex);
 			auto copiedEntry = m_dbStorage.at(index);
+			copiedEntry.values = std::move(newValues);
 
-			copiedEntry.values.clear();
-			if(requestedType.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
-			{
-				std::string concatStr;
-				for(const auto& v : values)
-				{
-					concatStr += (v + " "); // Try to make it as much similar as with a complete string "value" with at least 1 space between each substring
-					copiedEntry.values.emplace_back(v);
-				}
-
-				concatStr.pop_back(); // Remove the last redundant space " "
-				copiedEntry.values.emplace_back(concatStr);
-			}
-			else
-			{
-				for(const auto& v : values)
-				{
-					copiedEntry.values.emplace_back(v);
-				}
-			}
-
+			// The copied key still points into the Original DB arena, which lives as long as DbLoader does
 			m_modDbStorage.emplace_back(copiedEntry);
+			storeScalar(copiedEntry, values);
+			commitChange(copiedEntry, ChangeKind::UPDATED);
+			addToDictionary(copiedEntry.key, m_modDbStorage.size() - 1, m_modDbDictionary);
+			m_modKeyIndex.indexById[copiedEntry.id] = m_modDbStorage.size() - 1;
 
-			std::vector<std::string> subKeys = tokenize(copiedEntry.key, "/");
-			for(const auto& sk : subKeys)
-			{
-				m_modDbDictionary[sk].insert(m_modDbStorage.size() - 1); // Storing the index of entry in m_dbStorage vector
-			}
-
-			TPT_TRACE(TRACE_INFO, SSTR("Added entry ", copiedEntry.key, " into Modified DB successfully!"));
+			DB_TRACE(TRACE_INFO, "Added entry ", copiedEntry.key, " into Modified DB successfully!");
 			return m_modDbStorage.size() - 1;
 		}
 	}
@@ -0,0 +1,214 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <chrono>
+#include <cstdint>
+
+#include "databaseIf.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Lock-free operation counters and latency histograms of DbLoader.
+// Every thread writes into its own cache line aligned shard (threads share a shard only when there are more than NUMBER_OF_SHARDS),
+// getSnapshot() sums all shards up. When disabled every hook is a single relaxed load and branch.
+class DbStats
+{
+public:
+	enum class Operation
+	{
+		GET,
+		SOFT_UPDATE,
+		HARD_UPDATE,
+		ERASE,
+		RESTORE,
+		RESET,
+		GET_MANY,
+		NUMBER_OF_OPERATIONS
+	};
+
+	enum class Counter
+	{
+		MODIFIED_DB_HITS,
+		ORIGINAL_DB_HITS,
+		KEY_NOT_FOUND,
+		TYPE_MISMATCH,
+		NOT_WRITABLE,
+		UNCONTENDED_LOCKS,
+		FILTER_REJECTS,
+		FILTER_FALSE_POSITIVES,
+		READ_CACHE_HITS,
+		NUMBER_OF_COUNTERS
+	};
+
+	DbStats();
+	~DbStats() = default;
+
+	DbStats(const DbStats& other) = delete;
+	DbStats(DbStats&& other) = delete;
+	DbStats& operator=(const DbStats& other) = delete;
+	DbStats& operator=(DbStats&& other) = delete;
+
+	void setEnabled(bool isEnabled)
+	{
+		m_isEnabled.store(isEnabled, std::memory_order_relaxed);
+	}
+
+	bool isEnabled() const
+	{
+		return m_isEnabled.load(std::memory_order_relaxed);
+	}
+
+	// Returns 0 if stats are disabled, endOperation() then records nothing
+	uint64_t startOperation() const
+	{
+		return isEnabled() ? now() : 0;
+	}
+
+	void endOperation(Operation operation, uint64_t startNs, const ReturnCodeEnum& rc)
+	{
+		if(startNs == 0) return;
+
+		Shard& shard = getShard();
+		record(shard.latencies[static_cast<std::size_t>(operation)], now() - startNs);
+
+		switch (rc.getRawEnum())
+		{
+		case ReturnCodeRaw::KEY_NOT_FOUND:
+			increment(shard, Counter::KEY_NOT_FOUND);
+			break;
+		case ReturnCodeRaw::TYPE_MISMATCH:
+			increment(shard, Counter::TYPE_MISMATCH);
+			break;
+		case ReturnCodeRaw::NOT_WRITABLE:
+			increment(shard, Counter::NOT_WRITABLE);
+			break;
+		default:
+			break;
+		}
+	}
+
+	void count(Counter counter)
+	{
+		if(isEnabled()) increment(getShard(), counter);
+	}
+
+	// Drop-in for std::scoped_lock which records how long the calling thread had to wait for mtx.
+	// Only contended acquisitions read the clock, the uncontended fast path costs one try_lock.
+	template<typename Mutex>
+	std::unique_lock<Mutex> lock(Mutex& mtx)
+	{
+		if(!isEnabled()) return std::unique_lock<Mutex>(mtx);
+
+		std::unique_lock<Mutex> lock(mtx, std::try_to_lock);
+		Shard& shard = getShard();
+		if(lock.owns_lock())
+		{
+			increment(shard, Counter::UNCONTENDED_LOCKS);
+			return lock;
+		}
+
+		const uint64_t startNs = now();
+		lock.lock();
+		record(shard.lockWait, now() - startNs);
+		return lock;
+	}
+
+	// Same as lock() for the shared side of a std::shared_mutex, it only waits for a writer
+	template<typename Mutex>
+	std::shared_lock<Mutex> lockShared(Mutex& mtx)
+	{
+		if(!isEnabled()) return std::shared_lock<Mutex>(mtx);
+
+		std::shared_lock<Mutex> lock(mtx, std::try_to_lock);
+		Shard& shard = getShard();
+		if(lock.owns_lock())
+		{
+			increment(shard, Counter::UNCONTENDED_LOCKS);
+			return lock;
+		}
+
+		const uint64_t startNs = now();
+		lock.lock();
+		record(shard.lockWait, now() - startNs);
+		return lock;
+	}
+
+	DatabaseStats getSnapshot() const;
+
+	static uint64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+private:
+	static constexpr std::size_t NUMBER_OF_SHARDS = 16;
+
+	struct AtomicHistogram
+	{
+		std::array<std::atomic<uint64_t>, LatencyHistogram::NUMBER_OF_BUCKETS> buckets;
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> totalNs;
+		std::atomic<uint64_t> maxNs;
+	};
+
+	struct alignas(64) Shard
+	{
+		std::array<AtomicHistogram, static_cast<std::size_t>(Operation::NUMBER_OF_OPERATIONS)> latencies;
+		AtomicHistogram lockWait;
+		std::array<std::atomic<uint64_t>, static_cast<std::size_t>(Counter::NUMBER_OF_COUNTERS)> counters;
+	};
+
+	static void increment(Shard& shard, Counter counter)
+	{
+		shard.counters[static_cast<std::size_t>(counter)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void record(AtomicHistogram& histogram, uint64_t ns)
+	{
+		histogram.buckets[LatencyHistogram::getBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+		histogram.count.fetch_add(1, std::memory_order_relaxed);
+		histogram.totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+		uint64_t maxNs = histogram.maxNs.load(std::memory_order_relaxed);
+		while(ns > maxNs && !histogram.maxNs.compare_exchange_weak(maxNs, ns, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	Shard& getShard()
+	{
+		static std::atomic<std::size_t> nextShard {0};
+		static thread_local const std::size_t shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed) % NUMBER_OF_SHARDS;
+		return m_shards[shardIndex];
+	}
+
+	static void collect(const AtomicHistogram& histogram, LatencyHistogram& result);
+
+	std::atomic<bool> m_isEnabled {false};
+	std::unique_ptr<Shard[]> m_shards; // Zero-initialized, ~10 KB per shard
+
+}; // class DbStats
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,97 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "databaseIf.h"
+
+#include <stringUtils.h>
+#include <traceIf.h>
+
+// Severity of the trace levels used with DB_TRACE, in the same order as TraceLevel
+#define DBENGINE_TRACE_LEVEL_TRACE_INFO		0
+#define DBENGINE_TRACE_LEVEL_TRACE_ABN		1
+#define DBENGINE_TRACE_LEVEL_TRACE_ERROR	2
+
+// Trace points below this level are compiled out, e.g. -DDBENGINE_TRACE_MIN_LEVEL=2 only keeps TRACE_ERROR and 3 removes all of them
+#ifndef DBENGINE_TRACE_MIN_LEVEL
+#define DBENGINE_TRACE_MIN_LEVEL		0
+#endif
+
+// Replacement of TPT_TRACE(level, SSTR(...)) for DbLoader: DB_TRACE(TRACE_ABN, "Key ", key, " not found").
+// The message arguments are only evaluated and formatted if the level is compiled in and enabled at runtime,
+// so a disabled trace point costs one relaxed load and branch, and a compiled out one costs nothing.
+#define DB_TRACE(level, ...) \
+	do \
+	{ \
+		if constexpr(DBENGINE_TRACE_LEVEL_##level >= DBENGINE_TRACE_MIN_LEVEL) \
+		{ \
+			if(DbEngine::DatabaseIf::V1::DbTrace::isEnabled(DBENGINE_TRACE_LEVEL_##level)) \
+			{ \
+				TPT_TRACE(level, SSTR(__VA_ARGS__)); \
+			} \
+		} \
+	} while(0)
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Runtime minimum trace level of DbLoader, TraceLevel::INFO (everything compiled in) unless DBENGINE_TRACE_LEVEL=info|abn|error|none is set
+class DbTrace
+{
+public:
+	static void setLevel(TraceLevel level)
+	{
+		s_level.store(static_cast<int>(level), std::memory_order_relaxed);
+	}
+
+	static bool isEnabled(int level)
+	{
+		int minLevel = s_level.load(std::memory_order_relaxed);
+		if(minLevel < 0)
+		{
+			minLevel = getLevelFromEnv();
+		}
+		return level >= minLevel;
+	}
+
+private:
+	// Read lazily so that the level is valid even for traces emitted during static initialization
+	static int getLevelFromEnv()
+	{
+		TraceLevel level = TraceLevel::INFO;
+		if(const char* env = std::getenv("DBENGINE_TRACE_LEVEL"); env != nullptr)
+		{
+			if(std::strcmp(env, "abn") == 0) level = TraceLevel::ABN;
+			else if(std::strcmp(env, "error") == 0) level = TraceLevel::ERROR;
+			else if(std::strcmp(env, "none") == 0) level = TraceLevel::NONE;
+		}
+
+		int expected = -1;
+		s_level.compare_exchange_strong(expected, static_cast<int>(level), std::memory_order_relaxed);
+		return s_level.load(std::memory_order_relaxed);
+	}
+
+	inline static std::atomic<int> s_level {-1}; // -1 until the environment was read
+
+}; // class DbTrace
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,94 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// One bit per entry id telling whether the entry is erased. Setting, clearing and testing a bit are single atomic operations,
+// so erase() and restore() of a key neither copy its entry nor touch a dictionary. Sized once by reset() before any concurrent use.
+class ErasedBitmap
+{
+public:
+	ErasedBitmap() = default;
+	~ErasedBitmap() = default;
+
+	ErasedBitmap(const ErasedBitmap& other) = delete;
+	ErasedBitmap(ErasedBitmap&& other) = delete;
+	ErasedBitmap& operator=(const ErasedBitmap& other) = delete;
+	ErasedBitmap& operator=(ErasedBitmap&& other) = delete;
+
+	// Size the bitmap for ids 0 to numberOfIds - 1, all of them not erased
+	void reset(std::size_t numberOfIds);
+
+	bool test(std::size_t id) const
+	{
+		return id < m_numberOfIds && (m_words[id / 64].load(std::memory_order_relaxed) & getMask(id));
+	}
+
+	// True if the bit was not set before
+	bool set(std::size_t id)
+	{
+		if(id >= m_numberOfIds || (m_words[id / 64].fetch_or(getMask(id), std::memory_order_relaxed) & getMask(id))) return false;
+
+		m_count.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// True if the bit was set before
+	bool clear(std::size_t id)
+	{
+		if(id >= m_numberOfIds || !(m_words[id / 64].fetch_and(~getMask(id), std::memory_order_relaxed) & getMask(id))) return false;
+
+		m_count.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void clearAll();
+
+	// Number of set bits
+	std::size_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+	// Plain copy of the words, e.g. for a snapshot, see test(words, id)
+	std::vector<uint64_t> copyWords() const;
+
+	static bool test(const std::vector<uint64_t>& words, std::size_t id)
+	{
+		return id / 64 < words.size() && (words[id / 64] & getMask(id));
+	}
+
+	uint64_t getNumberOfBytes() const { return (m_numberOfIds + 63) / 64 * sizeof(uint64_t); }
+
+private:
+	static uint64_t getMask(std::size_t id)
+	{
+		return uint64_t {1} << (id % 64);
+	}
+
+	std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+	std::size_t m_numberOfIds {0};
+	std::atomic<std::size_t> m_count {0};
+
+}; // class ErasedBitmap
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,103 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "databaseIf.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Sampling tracker of the most read, written and missed keys. Each kind of access has a Space-Saving sketch with a bounded
+// number of counters, so memory does not grow with the number of distinct keys. Only every samplingPeriod-th access
+// of a thread is recorded, so the mutex and the O(capacity) eviction are off the common path.
+class HotKeyTracker
+{
+public:
+	enum class Access
+	{
+		READ,
+		WRITE,
+		MISS,
+		NUMBER_OF_ACCESSES
+	};
+
+	HotKeyTracker() = default;
+	~HotKeyTracker() = default;
+
+	HotKeyTracker(const HotKeyTracker& other) = delete;
+	HotKeyTracker(HotKeyTracker&& other) = delete;
+	HotKeyTracker& operator=(const HotKeyTracker& other) = delete;
+	HotKeyTracker& operator=(HotKeyTracker&& other) = delete;
+
+	// samplingPeriod 0 turns tracking off, changing it clears all sketches
+	void enable(uint32_t samplingPeriod, std::size_t capacity);
+
+	// Called on every access, true for every samplingPeriod-th access of the calling thread
+	bool isSampled()
+	{
+		const uint32_t samplingPeriod = m_samplingPeriod.load(std::memory_order_relaxed);
+		if(samplingPeriod == 0) return false;
+
+		thread_local uint32_t countdown = 0;
+		if(countdown > 0)
+		{
+			--countdown;
+			return false;
+		}
+
+		countdown = samplingPeriod - 1;
+		return true;
+	}
+
+	void record(Access access, std::string_view key);
+	HotKeyReport getReport(std::size_t topK) const;
+
+private:
+	class SpaceSaving
+	{
+	public:
+		void reset(std::size_t capacity);
+		void add(std::string_view key);
+		std::vector<HotKey> getTop(std::size_t topK, uint32_t scale) const;
+
+	private:
+		struct Counter
+		{
+			uint64_t count {0};
+			uint64_t error {0}; // Count of the evicted key this counter took over, i.e. the maximal overestimation
+		};
+
+		std::size_t m_capacity {0};
+		std::unordered_map<std::string, Counter> m_counters;
+	};
+
+	std::atomic<uint32_t> m_samplingPeriod {0};
+	mutable std::mutex m_mutex;
+	std::array<SpaceSaving, static_cast<std::size_t>(Access::NUMBER_OF_ACCESSES)> m_sketches;
+
+}; // class HotKeyTracker
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
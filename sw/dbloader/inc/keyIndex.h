@@ -0,0 +1,196 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Adaptive radix tree (ART) mapping whole keys to entry indices, with the node types 4, 16, 48 and 256 of Leis et al.
+// Compressed paths point into the inserted keys instead of copying them, so the keys must outlive the index (e.g. interned in a StringArena).
+// Children are kept in byte order, which gives ordered iteration. Not thread-safe for writes, concurrent reads are fine.
+class KeyIndex
+{
+public:
+	KeyIndex() = default;
+	~KeyIndex();
+
+	KeyIndex(const KeyIndex& other) = delete;
+	KeyIndex(KeyIndex&& other) = delete;
+	KeyIndex& operator=(const KeyIndex& other) = delete;
+	KeyIndex& operator=(KeyIndex&& other) = delete;
+
+	// Keeps the first value if key was already inserted
+	void insert(std::string_view key, uint32_t value);
+	std::optional<uint32_t> find(std::string_view key) const;
+
+	// Length and value of the longest inserted key which is key itself or a prefix of it followed by delimiter
+	std::optional<std::pair<std::size_t, uint32_t>> findLongestPrefix(std::string_view key, char delimiter) const;
+
+	// Call visitor(value) for all keys starting with prefix in key order, stop and return false as soon as visitor returns false
+	template<typename Visitor>
+	bool forEachWithPrefix(std::string_view prefix, Visitor&& visitor) const
+	{
+		const Node* node = m_root;
+		std::size_t depth = 0;
+		while(node != nullptr)
+		{
+			const std::size_t matched = matchPrefix(*node, prefix, depth);
+			if(depth + matched == prefix.size()) return visit(node, visitor); // prefix ends within this node's path
+
+			if(matched < node->prefixLength) return true;
+			depth += node->prefixLength;
+
+			Node* const* child = findChild(node, static_cast<uint8_t>(prefix[depth++]));
+			node = child ? *child : nullptr;
+		}
+
+		return true;
+	}
+
+	// True if key is prefix itself or continues it with '/' (or prefix ends with '/'), so /a/b is under /a but /a/bc is not under /a/b
+	static bool isUnderPrefix(std::string_view key, std::string_view prefix)
+	{
+		return key.substr(0, prefix.size()) == prefix && (key.size() == prefix.size() || prefix.empty() || prefix.back() == '/' || key[prefix.size()] == '/');
+	}
+
+	void clear();
+	std::size_t size() const { return m_size; }
+	uint64_t getNumberOfBytes() const { return m_numberOfBytes; }
+
+private:
+	static constexpr uint32_t NO_VALUE = UINT32_MAX;
+
+	enum class NodeType : uint8_t
+	{
+		LEAF,
+		NODE4,
+		NODE16,
+		NODE48,
+		NODE256
+	};
+
+	struct Node
+	{
+		NodeType type {NodeType::LEAF};
+		uint16_t numberOfChildren {0};
+		uint32_t value {NO_VALUE}; // Set if an inserted key ends at this node
+		uint32_t prefixLength {0};
+		const char* prefix {nullptr}; // Compressed path in front of the children
+	};
+
+	struct Node4 : Node
+	{
+		uint8_t keys[4];
+		Node* children[4];
+	};
+
+	struct Node16 : Node
+	{
+		uint8_t keys[16];
+		Node* children[16];
+	};
+
+	struct Node48 : Node
+	{
+		uint8_t childIndex[256]; // 0 if there is no child for this byte, its slot in children + 1 otherwise
+		Node* children[48];
+	};
+
+	struct Node256 : Node
+	{
+		Node* children[256];
+	};
+
+	static std::size_t matchPrefix(const Node& node, std::string_view key, std::size_t depth)
+	{
+		std::size_t i = 0;
+		while(i < node.prefixLength && depth + i < key.size() && node.prefix[i] == key[depth + i]) ++i;
+		return i;
+	}
+
+	template<typename Visitor>
+	static bool visit(const Node* node, Visitor& visitor)
+	{
+		if(node->value != NO_VALUE && !visitor(node->value)) return false;
+
+		switch(node->type)
+		{
+		case NodeType::NODE4:
+			for(uint16_t i = 0; i < node->numberOfChildren; ++i)
+			{
+				if(!visit(static_cast<const Node4*>(node)->children[i], visitor)) return false;
+			}
+			break;
+
+		case NodeType::NODE16:
+			for(uint16_t i = 0; i < node->numberOfChildren; ++i)
+			{
+				if(!visit(static_cast<const Node16*>(node)->children[i], visitor)) return false;
+			}
+			break;
+
+		case NodeType::NODE48:
+			for(std::size_t byte = 0; byte < 256; ++byte)
+			{
+				const uint8_t slot = static_cast<const Node48*>(node)->childIndex[byte];
+				if(slot && !visit(static_cast<const Node48*>(node)->children[slot - 1], visitor)) return false;
+			}
+			break;
+
+		case NodeType::NODE256:
+			for(const Node* child : static_cast<const Node256*>(node)->children)
+			{
+				if(child && !visit(child, visitor)) return false;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		return true;
+	}
+
+	static Node* const* findChild(const Node* node, uint8_t byte);
+	Node* makeLeaf(std::string_view key, std::size_t depth, uint32_t value);
+	void addChild(Node** ref, uint8_t byte, Node* child);
+	Node* grow(Node* node);
+	void freeNode(Node* node);
+	void freeTree(Node* node);
+
+	template<typename T>
+	T* allocate(NodeType type)
+	{
+		T* node = new T();
+		node->type = type;
+		m_numberOfBytes += sizeof(T);
+		return node;
+	}
+
+	Node* m_root {nullptr};
+	std::size_t m_size {0};
+	uint64_t m_numberOfBytes {0};
+
+}; // class KeyIndex
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,109 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "databaseIf.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Opt-in per-thread cache of decoded get() results, direct-mapped by key hash. Every entry is tagged with the DB version read
+// before its values, so any write since then turns it into a miss: a hit costs one atomic load of the version, a hash of the key
+// and one probe into memory of the calling thread only. Only successful reads are cached.
+class ReadCache
+{
+public:
+	ReadCache() = default;
+	~ReadCache() = default;
+
+	ReadCache(const ReadCache& other) = delete;
+	ReadCache(ReadCache&& other) = delete;
+	ReadCache& operator=(const ReadCache& other) = delete;
+	ReadCache& operator=(ReadCache&& other) = delete;
+
+	// capacity 0 turns the cache off (the default), otherwise it is rounded up to a power of two entries per thread.
+	// Every thread drops its entries on its next get() after a change.
+	void enable(std::size_t capacity);
+
+	bool isEnabled() const
+	{
+		return m_capacity.load(std::memory_order_relaxed) != 0;
+	}
+
+	template<typename T>
+	bool find(const std::string& key, uint64_t version, std::vector<T>& values)
+	{
+		const std::size_t hash = std::hash<std::string_view> {}(key);
+		const Slot* slot = getSlot(hash);
+		if(slot == nullptr || !slot->isValid || slot->version != version || slot->hash != hash || slot->key != key) return false;
+
+		const auto* cachedValues = std::any_cast<std::vector<T>>(&slot->values);
+		if(cachedValues == nullptr) return false; // Read as another type
+
+		values = *cachedValues;
+		return true;
+	}
+
+	// version must have been loaded before values were read, so that a write in between leaves the entry already stale
+	template<typename T>
+	void insert(const std::string& key, uint64_t version, const std::vector<T>& values)
+	{
+		const std::size_t hash = std::hash<std::string_view> {}(key);
+		Slot* slot = getSlot(hash);
+		if(slot == nullptr) return;
+
+		slot->isValid = true;
+		slot->version = version;
+		slot->hash = hash;
+		slot->key = key;
+		slot->values = values;
+	}
+
+private:
+	struct Slot
+	{
+		bool isValid {false};
+		uint64_t version {0};
+		std::size_t hash {0};
+		std::string key;
+		std::any values; // std::vector<T> of the type it was read as
+	};
+
+	struct LocalCache
+	{
+		uint64_t configuration {0};
+		std::vector<Slot> slots;
+	};
+
+	// Slot of hash in the cache of the calling thread, which is rebuilt first if the capacity changed. nullptr if disabled.
+	Slot* getSlot(std::size_t hash);
+
+	std::atomic<std::size_t> m_capacity {0};
+	std::atomic<uint64_t> m_configuration {0}; // Incremented by every enable()
+
+}; // class ReadCache
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
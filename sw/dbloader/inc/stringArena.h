@@ -0,0 +1,71 @@
+/*
+* ________________     __________              _____             
+* ___  __ \__  __ )    ___  ____/_____________ ___(_)___________ 
+* __  / / /_  __  |    __  __/  __  __ \_  __ `/_  /__  __ \  _ \
+* _  /_/ /_  /_/ /     _  /___  _  / / /  /_/ /_  / _  / / /  __/
+* /_____/ /_____/      /_____/  /_/ /_/_\__, / /_/  /_/ /_/\___/ 
+*                                      /____/                    
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <unordered_set>
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+// Bump allocator which stores every string of a database only once (keys, sub-keys and CHAR values).
+// Returned string_views stay valid until clear() is called or the arena is destroyed, blocks are never moved.
+// Not thread-safe, callers must hold the lock of the database that owns the arena.
+class StringArena
+{
+public:
+	explicit StringArena(std::size_t blockSize = 4096);
+	~StringArena() = default;
+
+	StringArena(const StringArena& other) = delete;
+	StringArena(StringArena&& other) = delete;
+	StringArena& operator=(const StringArena& other) = delete;
+	StringArena& operator=(StringArena&& other) = delete;
+
+	// Return the interned copy of str, str is only copied into the arena if it has not been seen before
+	std::string_view intern(std::string_view str);
+
+	// Release all blocks, all previously returned string_views become dangling
+	void clear();
+
+	std::size_t getNumberOfStrings() const;
+	std::size_t getNumberOfBytesUsed() const;
+	std::size_t getNumberOfBytesReserved() const;
+
+private:
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		std::size_t used {0};
+		std::size_t capacity {0};
+	};
+
+	std::string_view allocate(std::string_view str);
+
+	std::size_t m_blockSize;
+	std::vector<Block> m_blocks;
+	std::unordered_set<std::string_view> m_internedStrings;
+	std::size_t m_bytesUsed {0};
+	std::size_t m_bytesReserved {0};
+
+}; // class StringArena
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
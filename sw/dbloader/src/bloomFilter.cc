@@ -0,0 +1,47 @@
+#include <cmath>
+
+#include "bloomFilter.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+void BloomFilter::reset(std::size_t expectedStrings)
+{
+	m_words.clear();
+	m_words.shrink_to_fit();
+	if(expectedStrings == 0) return;
+
+	std::size_t numberOfWords = 1;
+	while(numberOfWords * 64 < expectedStrings * WORD_BITS_PER_STRING)
+	{
+		numberOfWords *= 2;
+	}
+
+	m_words.assign(numberOfWords, 0);
+}
+
+double BloomFilter::getFalsePositiveRate(std::size_t numberOfStrings) const
+{
+	if(m_words.empty()) return 1.0;
+
+	// Sum over the Poisson distributed number of strings per word of the classic Bloom filter rate of a 64-bit filter
+	const double stringsPerWord = static_cast<double>(numberOfStrings) / m_words.size();
+	double rate = 0.0;
+	double probability = std::exp(-stringsPerWord);
+	for(uint32_t n = 0; n < 64; ++n)
+	{
+		rate += probability * std::pow(1.0 - std::pow(1.0 - 1.0 / 64, static_cast<double>(BITS_PER_STRING) * n), BITS_PER_STRING);
+		probability *= stringsPerWord / (n + 1);
+	}
+	return rate;
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,186 @@
+#include <cerrno>
+#include <exception>
+#include <unordered_map>
+
+#include "changeNotifier.h"
+#include "dbTrace.h"
+#include "keyIndex.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+ChangeNotifier::ChangeNotifier()
+{
+	sem_init(&m_wakeUp, 0, 0);
+}
+
+ChangeNotifier::~ChangeNotifier()
+{
+	m_isStopped.store(true, std::memory_order_relaxed);
+	sem_post(&m_wakeUp);
+	if(m_thread.joinable())
+	{
+		m_thread.join();
+	}
+
+	deleteNodes(m_head.exchange(nullptr, std::memory_order_acquire));
+	sem_destroy(&m_wakeUp);
+}
+
+void ChangeNotifier::publish(std::string_view key, ChangeKind kind)
+{
+	Node* node = new Node {std::string(key), kind, m_head.load(std::memory_order_relaxed)};
+	while(!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+
+	// The dispatcher takes the whole stack at once, so it only needs waking when the stack was empty. sem_post() never blocks.
+	if(node->next == nullptr) sem_post(&m_wakeUp);
+}
+
+SubscriptionId ChangeNotifier::subscribe(std::string_view prefix, EventCallback callback, BatchCallback batchCallback)
+{
+	auto subscription = std::make_shared<Subscription>();
+	subscription->prefix = prefix;
+	subscription->callback = std::move(callback);
+	subscription->batchCallback = std::move(batchCallback);
+
+	std::scoped_lock<std::mutex> lock(m_subscriptionsMutex);
+	subscription->id = m_nextId++;
+	m_subscriptions.push_back(subscription);
+	m_numberOfSubscriptions.fetch_add(1, std::memory_order_relaxed);
+
+	if(!m_thread.joinable())
+	{
+		m_thread = std::thread(&ChangeNotifier::run, this);
+	}
+
+	DB_TRACE(TRACE_INFO, "Subscription ", subscription->id, " to changes under ", prefix);
+	return subscription->id;
+}
+
+bool ChangeNotifier::unsubscribe(SubscriptionId id)
+{
+	std::shared_ptr<Subscription> subscription;
+	{
+		std::scoped_lock<std::mutex> lock(m_subscriptionsMutex);
+		for(auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it)
+		{
+			if((*it)->id != id) continue;
+
+			subscription = *it;
+			m_subscriptions.erase(it);
+			break;
+		}
+	}
+
+	if(!subscription) return false;
+
+	subscription->isActive.store(false, std::memory_order_relaxed);
+	m_numberOfSubscriptions.fetch_sub(1, std::memory_order_relaxed);
+
+	// Wait for a running callback to return, a callback unsubscribing itself must not wait for itself
+	if(std::this_thread::get_id() != m_thread.get_id())
+	{
+		std::scoped_lock<std::mutex> lock(m_deliveryMutex);
+	}
+
+	return true;
+}
+
+void ChangeNotifier::run()
+{
+	std::vector<ChangeEvent> events;
+	std::unordered_map<std::string_view, std::size_t> positions;
+	std::vector<Node*> nodes;
+	while(true)
+	{
+		while(sem_wait(&m_wakeUp) != 0 && errno == EINTR)
+		{
+		}
+
+		if(m_isStopped.load(std::memory_order_relaxed)) return;
+
+		Node* head = m_head.exchange(nullptr, std::memory_order_acquire);
+		if(head == nullptr) continue; // Posted for changes which an earlier round already took
+
+		// The stack has the most recent change first, walk it backwards so that events keep the order of the first change of their key
+		for(Node* node = head; node != nullptr; node = node->next)
+		{
+			nodes.push_back(node);
+		}
+
+		for(auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+		{
+			const Node& node = **it;
+			if(const auto [position, isInserted] = positions.emplace(node.key, events.size()); !isInserted)
+			{
+				events[position->second].kind = node.kind;
+				continue;
+			}
+
+			events.push_back(ChangeEvent {node.key, node.kind});
+		}
+
+		deliver(events);
+
+		events.clear();
+		positions.clear();
+		nodes.clear();
+		deleteNodes(head);
+	}
+}
+
+void ChangeNotifier::deliver(const std::vector<ChangeEvent>& events)
+{
+	std::vector<std::shared_ptr<Subscription>> subscriptions;
+	{
+		std::scoped_lock<std::mutex> lock(m_subscriptionsMutex);
+		subscriptions = m_subscriptions;
+	}
+
+	// Callbacks may subscribe and unsubscribe, they only take m_subscriptionsMutex which is not held here
+	std::scoped_lock<std::mutex> lock(m_deliveryMutex);
+	std::vector<ChangeEvent> batch;
+	for(const auto& subscription : subscriptions)
+	{
+		try
+		{
+			for(const auto& event : events)
+			{
+				if(!KeyIndex::isUnderPrefix(event.key, subscription->prefix)) continue;
+
+				if(subscription->batchCallback) batch.push_back(event);
+				else if(subscription->isActive.load(std::memory_order_relaxed)) subscription->callback(event);
+			}
+
+			if(!batch.empty() && subscription->isActive.load(std::memory_order_relaxed)) subscription->batchCallback(batch);
+		}
+		catch(const std::exception& e)
+		{
+			DB_TRACE(TRACE_ABN, "Callback of subscription ", subscription->id, " threw: ", e.what());
+		}
+
+		batch.clear();
+	}
+}
+
+void ChangeNotifier::deleteNodes(Node* node)
+{
+	while(node != nullptr)
+	{
+		Node* next = node->next;
+		delete node;
+		node = next;
+	}
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -1,8 +1,20 @@
 #include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <functional>
+#include <thread>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "dbLoader.h"
 
+// Defined by the source which textToBin -c generates, null unless it is linked into the executable
+extern "C" const unsigned char dbengine_swdb_image[] __attribute__((weak));
+extern "C" const std::size_t dbengine_swdb_image_size __attribute__((weak));
+
 namespace DbEngine
 {
 namespace DatabaseIf
@@ -16,270 +28,656 @@ DbLoader& DbLoader::getInstance()
 	return instance;
 }
 
-DbLoader::DbLoader()
+DbLoader::DbLoader() : m_binDbPath(getBinDbPath())
 {
-	// Load Original Database
-	if(!loadDb(m_binDbPath + "/swdb.bin"))
+	const uint64_t startNs = DbStats::now();
+
+	// Load Original Database, from the image linked into the executable if there is one, so that no file is read at all
+	if(const auto image = getEmbeddedDbImage(); image.has_value())
 	{
-		TPT_TRACE(TRACE_ERROR, SSTR("Failed to load DB binary file ", m_binDbPath, "/swdb.bin"));
+		m_loadStats.isEmbedded = true;
+		m_loadStats.isLoaded = loadDbImage(image.value(), true);
+		if(!m_loadStats.isLoaded)
+		{
+			DB_TRACE(TRACE_ERROR, "Failed to load the embedded DB image of ", image.value().size(), " bytes");
+		}
+	}
+	else
+	{
+		m_loadStats.isLoaded = loadDb(m_binDbPath + "/swdb.bin");
+		if(!m_loadStats.isLoaded)
+		{
+			DB_TRACE(TRACE_ERROR, "Failed to load DB binary file ", m_binDbPath, "/swdb.bin");
+		}
 	}
 
 	// Load Hard-Saved Database into Modified Data structures
+	const uint64_t hardSaveStartNs = DbStats::now();
 	if(!loadHardSavedDb(m_binDbPath + "/swdb-hardsave.bin"))
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Failed to load DB binary file ", m_binDbPath, "/swdb-hardsave.bin"));
+		DB_TRACE(TRACE_ABN, "Failed to load DB binary file ", m_binDbPath, "/swdb-hardsave.bin");
 	}
+	m_loadStats.hardSaveReplayNs = DbStats::now() - hardSaveStartNs;
+	std::sort(m_hardSavedIds.begin(), m_hardSavedIds.end());
+	m_erasedEntries.reset(m_dbStorage.size() + m_numberOfHardSavedOnlyIds);
+
+	m_loadStats.totalNs = DbStats::now() - startNs;
+	m_loadStats.arenaBytes = m_dbArena.getNumberOfBytesUsed() + m_modDbArena.getNumberOfBytesUsed();
+	m_loadStats.numberOfHardSavedEntries = m_modDbStorage.size();
+
+	struct rusage usage {};
+	if(getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+		m_loadStats.peakRssKb = usage.ru_maxrss; // Linux reports kilobytes
+	}
+
+	traceLoadStats();
+	startWarmUp();
 }
 
-bool DbLoader::loadDb(const std::string& binFilePath)
+DbLoader::~DbLoader()
 {
-	std::ifstream dbFile(binFilePath, std::ifstream::binary);
-	if(!dbFile.is_open())
+	m_isWarmUpStopped.store(true, std::memory_order_relaxed);
+	if(m_warmUpThread.joinable())
+	{
+		m_warmUpThread.join();
+	}
+}
+
+void DbLoader::startWarmUp()
+{
+	// The manifest lists one key per line (comment lines start with "/*"), e.g. the file written by exportHotKeys()
+	const std::string manifestPath = m_binDbPath + "/swdb-hotkeys.txt";
+	if(!m_loadStats.isLoaded || access(manifestPath.c_str(), R_OK) != 0) return;
+
+	uint64_t budgetMs = 100;
+	if(const char* env = std::getenv("DBENGINE_WARMUP_BUDGET_MS"); env != nullptr)
+	{
+		budgetMs = std::strtoull(env, nullptr, 10);
+	}
+	if(budgetMs == 0) return;
+
+	const char* env = std::getenv("DBENGINE_WARMUP_MLOCK");
+	const bool isLocked = env != nullptr && std::strcmp(env, "1") == 0;
+
+	// Runs next to the first requests, which only share the DB locks with it for the duration of a single lookup
+	m_warmUpThread = std::thread(&DbLoader::warmUp, this, manifestPath, budgetMs * 1000000, isLocked);
+}
+
+void DbLoader::warmUp(const std::string& manifestPath, uint64_t budgetNs, bool isLocked)
+{
+	const uint64_t startNs = DbStats::now();
+
+	std::ifstream manifest(manifestPath);
+	if(!manifest.is_open())
+	{
+		DB_TRACE(TRACE_ABN, "Could not open hot-key manifest ", manifestPath);
+		return;
+	}
+
+	std::size_t numberOfKeys = 0;
+	std::size_t numberOfWarmedKeys = 0;
+	bool isOverBudget = false;
+	std::string line;
+	while(std::getline(manifest, line))
+	{
+		if(m_isWarmUpStopped.load(std::memory_order_relaxed)) return;
+		if(DbStats::now() - startNs > budgetNs)
+		{
+			isOverBudget = true;
+			break;
+		}
+
+		const std::string_view key = std::string_view(line).substr(0, line.find_first_of(" \t\r"));
+		if(key.empty() || key.substr(0, 2) == "/*") continue;
+
+		++numberOfKeys;
+		if(warmUpEntry(key, isLocked)) ++numberOfWarmedKeys;
+	}
+
+	DB_TRACE(TRACE_INFO, "Warmed up ", numberOfWarmedKeys, " of ", numberOfKeys, " hot keys from ", manifestPath, " in ",
+		DbStats::now() - startNs, " ns", isOverBudget ? ", stopped by the time budget" : "");
+}
+
+bool DbLoader::warmUpEntry(std::string_view key, bool& isLocked)
+{
+	// Same lookup as findMatchingIndices(), without counting the hits in the operation stats
+	auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
+	bool isFoundInModDb = true;
+	std::vector<std::size_t> indices;
+	{
+		auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+		if(const auto wholeKey = findWholeKey(key, m_modKeyIndex); wholeKey.has_value())
+		{
+			indices.assign(1, wholeKey->first);
+			isFoundInModDb = wholeKey->second;
+		}
+	}
+	if(indices.empty()) indices = findMatchingKeys(key, m_modDbDictionary, m_modDictionaryMutex);
+	if(indices.empty())
+	{
+		isFoundInModDb = false;
+		indices = findMatchingKeys(key, m_dbDictionary, m_dictionaryMutex);
+		if(indices.empty())
+		{
+			DB_TRACE(TRACE_ABN, "Hot key ", key, " could not be found");
+			return false;
+		}
+	}
+
+	std::shared_mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
+	const DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
+
+	const auto lockPages = [](const void* addr, std::size_t size){
+		static const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+		const uintptr_t begin = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+		const uintptr_t end = reinterpret_cast<uintptr_t>(addr) + size;
+		return size == 0 || mlock(reinterpret_cast<const void*>(begin), end - begin) == 0;
+	};
+
+	// Read every byte the first get() will read, so that page faults and cache misses are taken here
+	volatile char sink = 0;
+	auto lockStorage = m_stats.lockShared(mtx);
+	const DbEntry& entry = dbStorage.at(indices.front());
+	for(const char c : entry.key) sink = sink + c;
+
+	bool isOk = !isLocked || (lockPages(&entry, sizeof(entry)) && lockPages(entry.key.data(), entry.key.size()));
+	if(entry.values)
+	{
+		const DbValues& values = *entry.values;
+		isOk = isOk && (!isLocked || lockPages(values.data(), values.size() * sizeof(std::any)));
+		for(const std::any& v : values)
+		{
+			if(entry.type.getRawEnum() != DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR || !v.has_value()) continue;
+
+			const auto* str = std::any_cast<std::string_view>(&v);
+			if(str == nullptr) continue;
+			for(const char c : *str) sink = sink + c;
+			isOk = isOk && (!isLocked || lockPages(str->data(), str->size()));
+		}
+	}
+
+	if(!isOk)
+	{
+		// Typically RLIMIT_MEMLOCK, keep warming the remaining keys without locking
+		DB_TRACE(TRACE_ABN, "Could not lock the pages of hot key ", key, ": ", std::strerror(errno));
+		isLocked = false;
+	}
+	return true;
+}
+
+void DbLoader::traceLoadStats()
+{
+	// One event with the whole breakdown, so that boot cost can be tracked per DB revision and content size
+	DB_TRACE(TRACE_INFO, "DB load profile: revision ", m_loadStats.dbRevision, ", ", m_loadStats.fileBytes, " bytes",
+		m_loadStats.isEmbedded ? " embedded, " : ", ",
+		m_loadStats.numberOfEntries, " entries, ", m_loadStats.numberOfUniqueValues, " unique values, ",
+		m_loadStats.numberOfHardSavedEntries, " hard-saved entries, ", m_loadStats.numberOfConversions, " conversions (",
+		m_loadStats.numberOfConversionFailures, " failed), arena ", m_loadStats.arenaBytes, " bytes, total ", m_loadStats.totalNs,
+		" ns: file read ", m_loadStats.fileReadNs, " ns, crc ", m_loadStats.crcNs, " ns, keys ", m_loadStats.keyParsingNs,
+		" ns, values ", m_loadStats.valueConversionNs, " ns, dictionary ", m_loadStats.dictionaryNs, " ns, hard-save replay ",
+		m_loadStats.hardSaveReplayNs, " ns, peak RSS ", m_loadStats.peakRssKb, " KB");
+}
+
+std::string DbLoader::getBinDbPath()
+{
+	// DBENGINE_SWDB_DIR allows tools and benchmarks to load another DB without rebuilding, it must be set before the first DB access
+	if(const char* dir = std::getenv("DBENGINE_SWDB_DIR"); dir && *dir)
+	{
+		return dir;
+	}
+
+	return "/home/giangnguyentbk/workspace/dbengine/sw/texttobin/swdb"; // currently hardcoded
+}
+
+std::optional<std::string_view> DbLoader::getEmbeddedDbImage()
+{
+	if(dbengine_swdb_image == nullptr || &dbengine_swdb_image_size == nullptr) return std::nullopt;
+
+	// DBENGINE_EMBEDDED_DB=0 loads swdb.bin even so, e.g. to try out a new DB without relinking
+	if(const char* env = std::getenv("DBENGINE_EMBEDDED_DB"); env != nullptr && std::strcmp(env, "0") == 0)
+	{
+		DB_TRACE(TRACE_INFO, "Ignoring the embedded DB image, DBENGINE_EMBEDDED_DB is 0");
+		return std::nullopt;
+	}
+
+	return std::string_view(reinterpret_cast<const char*>(dbengine_swdb_image), dbengine_swdb_image_size);
+}
+
+void DbLoader::recordHotKey(const std::string& key, const ReturnCodeEnum& rc, HotKeyTracker::Access access)
+{
+	if(rc.getRawEnum() == ReturnCodeRaw::OK) m_hotKeys.record(access, key);
+	else if(rc.getRawEnum() == ReturnCodeRaw::KEY_NOT_FOUND) m_hotKeys.record(HotKeyTracker::Access::MISS, key);
+}
+
+bool DbLoader::exportHotKeys(const std::string& filePath, std::size_t topK) const
+{
+	const HotKeyReport report = m_hotKeys.getReport(topK);
+	if(report.samplingPeriod == 0)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", binFilePath));
+		DB_TRACE(TRACE_ABN, "Hot-key tracking is off, nothing to export into ", filePath);
 		return false;
 	}
 
-	char c;
+	// Merge reads and writes of the same key, hottest first
+	std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> counts;
+	for(const auto& hotKey : report.reads) counts[hotKey.key].first = hotKey.count;
+	for(const auto& hotKey : report.writes) counts[hotKey.key].second = hotKey.count;
 
-	// DB Header Tag check
-	c = dbFile.get();
-	if(c != 'H')
+	std::vector<std::pair<std::string, std::pair<uint64_t, uint64_t>>> hotKeys(counts.begin(), counts.end());
+	std::sort(hotKeys.begin(), hotKeys.end(), [](const auto& lhs, const auto& rhs){
+		const uint64_t lhsTotal = lhs.second.first + lhs.second.second;
+		const uint64_t rhsTotal = rhs.second.first + rhs.second.second;
+		return lhsTotal != rhsTotal ? lhsTotal > rhsTotal : lhs.first < rhs.first;
+	});
+
+	std::ofstream manifest(filePath);
+	if(!manifest.is_open())
 	{
-		TPT_TRACE(TRACE_ERROR, SSTR("The DB Header Tag 'H' was not correct ", std::string(1, c)));
-		dbFile.close();
+		DB_TRACE(TRACE_ERROR, "Could not open hot-key manifest ", filePath);
 		return false;
 	}
 
-	// DB Revision check, currently hardcoded = 10
-	c = dbFile.get();
-	if(c != 10)
+	// Same comment syntax as the text DB files. Format: <key>	<estimated reads>	<estimated writes>
+	manifest << "/* Hot keys: " << hotKeys.size() << " keys, sampling period " << report.samplingPeriod << " */\n";
+	for(const auto& [key, readsAndWrites] : hotKeys)
 	{
-		TPT_TRACE(TRACE_ERROR, SSTR("The DB Revision '10' was not correct ", (int)c));
-		dbFile.close();
+		manifest << key << '\t' << readsAndWrites.first << '\t' << readsAndWrites.second << '\n';
+	}
+
+	manifest.close();
+	if(!manifest)
+	{
+		DB_TRACE(TRACE_ERROR, "Failed to write hot-key manifest ", filePath);
 		return false;
 	}
 
-	// Ignore 4 reserved bytes for future uses of DB parameters
-	for(int i = 0; i < 4; ++i) (void)dbFile.get();
+	DB_TRACE(TRACE_INFO, "Exported ", hotKeys.size(), " hot keys into ", filePath);
+	return true;
+}
 
-	// Read 4 bytes of total number bytes of DB entries (payload)
-	uint8_t buff[4];
-	for(int i = 0; i < 4; ++i) buff[i] = dbFile.get();
-	uint32_t totalPayloadBytes = be32toh(*(uint32_t *)buff); // When converting text-based DB file into binary file, we used Big Endian
-	TPT_TRACE(TRACE_INFO, SSTR("Total DB entry's payload size: ", totalPayloadBytes, " bytes!"));
+MemoryUsage DbLoader::getMemoryUsage(uint32_t prefixDepth)
+{
+	MemoryUsage usage;
+	std::unordered_set<const DbValues*> countedValues;
 
-	std::vector<uint8_t> payload;
-	payload.reserve(totalPayloadBytes);
-	// Analyze DB entries
-	for(auto i = 0u; i < totalPayloadBytes && c != EOF; ++i)
 	{
-		c = dbFile.get();
-		payload.push_back(c);
-		if(c == 'F')
+		auto lockStorage = m_stats.lockShared(m_storageMutex);
+		auto lockDictionary = m_stats.lockShared(m_dictionaryMutex);
+		addMemoryUsage(m_dbStorage, m_dbDictionary, m_dbArena, prefixDepth, countedValues, usage.original, usage.perPrefix);
+
+		usage.original.keyIndex = {m_keyIndex.size(), m_keyIndex.getNumberOfBytes()};
+		usage.original.tokenFilter = {m_dbDictionary.size(), m_tokenFilter.getNumberOfBytes()};
+		usage.original.scalarSlots = {m_numberOfScalarSlots, m_numberOfScalarSlots * sizeof(ScalarSlot)};
+		usage.original.versionStamps = {m_dbStorage.size(), m_entryVersions ? m_dbStorage.size() * sizeof(std::atomic<uint64_t>) : 0};
+		usage.original.erasedBits = {m_erasedEntries.count(), m_erasedEntries.getNumberOfBytes()};
+		usage.original.totalBytes += usage.original.keyIndex.bytes + usage.original.tokenFilter.bytes + usage.original.scalarSlots.bytes +
+			usage.original.versionStamps.bytes + usage.original.erasedBits.bytes;
+	}
+
+	{
+		auto lockStorage = m_stats.lockShared(m_modStorageMutex);
+		auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+		addMemoryUsage(m_modDbStorage, m_modDbDictionary, m_modDbArena, prefixDepth, countedValues, usage.modified, usage.perPrefix);
+
+		// Same hash table estimate as for the dictionary tokens
+		const auto& [indexById, hardSavedOnlyIds] = m_modKeyIndex;
+		usage.modified.keyIndex.count = indexById.size();
+		usage.modified.keyIndex.bytes = (indexById.bucket_count() + hardSavedOnlyIds.bucket_count()) * sizeof(void*)
+			+ indexById.size() * (sizeof(void*) + sizeof(ModifiedKeyIndex::IndexById::value_type))
+			+ hardSavedOnlyIds.size() * (sizeof(void*) + sizeof(ModifiedKeyIndex::HardSavedOnlyIds::value_type) + sizeof(std::size_t));
+		usage.modified.totalBytes += usage.modified.keyIndex.bytes;
+	}
+
+	usage.totalBytes = usage.original.totalBytes + usage.modified.totalBytes;
+	return usage;
+}
+
+void DbLoader::addMemoryUsage(const DatabaseStorage& dbStorage, const DatabaseDictionary& dbDictionary, const StringArena& arena, uint32_t prefixDepth,
+	std::unordered_set<const DbValues*>& countedValues, MemoryUsage::Db& usage, std::map<std::string, MemoryUsage::Part>& perPrefix)
+{
+	usage.entries.count = dbStorage.size();
+	usage.entries.bytes = dbStorage.capacity() * sizeof(DbEntry);
+	usage.arena.count = arena.getNumberOfStrings();
+	usage.arena.bytes = arena.getNumberOfBytesReserved();
+
+	// Prefixes are views into the interned keys while the locks are held, they are copied into perPrefix once at the end
+	std::unordered_map<std::string_view, MemoryUsage::Part> prefixUsages;
+	const bool isOwningStrings = &dbStorage == &m_modDbStorage; // See OwnedStringValues
+	std::unordered_map<int32_t, MemoryUsage::Part> typeUsages;
+
+	for(const auto& entry : dbStorage)
+	{
+		uint64_t entryBytes = sizeof(DbEntry) + entry.key.length();
+
+		// Shared values are counted by the first entry which refers to them, only those need to be remembered.
+		// Entries of the Modified DB may still share their values with the Original DB, those belong to the Original DB.
+		if(entry.values && (entry.values.use_count() == 1 || countedValues.insert(entry.values.get()).second))
 		{
-			// Start a new entry
-			DbEntry newEntry;
+			const uint64_t valuesBytes = getValuesBytes(entry.type, *entry.values, isOwningStrings);
+			MemoryUsage::Part& typeUsage = typeUsages[entry.type.toS32()];
+			++typeUsage.count;
+			typeUsage.bytes += valuesBytes;
+			++usage.values.count;
+			usage.values.bytes += valuesBytes;
+			entryBytes += valuesBytes;
+		}
 
-			// Read the "key" in null-terminated string format
-			while((c = dbFile.get()) != '\0')
+		if(prefixDepth > 0)
+		{
+			// The prefix is the key up to the end of its prefixDepth-th sub-key
+			std::size_t end = 0;
+			for(uint32_t depth = 0; depth < prefixDepth && end != std::string_view::npos; ++depth)
 			{
-				payload.push_back(c);
-				newEntry.key += c;
-				++i;
+				end = entry.key.find('/', end + 1);
 			}
-			++i;
-			payload.push_back(c);
-
-			// Read 1 byte of "permission"
-			c = dbFile.get();
-			payload.push_back(c);
-			++i;
-			switch (c)
-			{
-			case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_ONLY)):
-				newEntry.permission.set(DbPermissionEnumRaw::PERM_READ_ONLY);
-				break;
+			MemoryUsage::Part& prefixUsage = prefixUsages[entry.key.substr(0, end)];
+			++prefixUsage.count;
+			prefixUsage.bytes += entryBytes;
+		}
+	}
 
-			case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_WRITE)):
-				newEntry.permission.set(DbPermissionEnumRaw::PERM_READ_WRITE);
-				break;
-			
-			default:
-				TPT_TRACE(TRACE_ERROR, SSTR("EnumPermission of this DB Entry was not recognized, ", (int)c));
-				dbFile.close();
-				return false;
-			}
+	for(const auto& [type, typeUsage] : typeUsages)
+	{
+		usage.valuesPerType[DbTypeEnum(static_cast<DbTypeEnumRaw>(type)).toString()] = typeUsage;
+	}
 
-			// Read 1 byte of "type"
-			c = dbFile.get();
-			payload.push_back(c);
-			++i;
-			switch (c)
-			{
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U8)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U8);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S8)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S8);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U16)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U16);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S16)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S16);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U32)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U32);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S32)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S32);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U64)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U64);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S64)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S64);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR);
-				break;
-			default:
-				TPT_TRACE(TRACE_ERROR, SSTR("EnumType of this DB Entry was not recognized, ", (int)c));
-				dbFile.close();
-				return false;
-			}
+	for(const auto& [prefix, prefixUsage] : prefixUsages)
+	{
+		MemoryUsage::Part& total = perPrefix[std::string(prefix)];
+		total.count += prefixUsage.count;
+		total.bytes += prefixUsage.bytes;
+	}
 
-			// Read the "value" in null-terminated string format
-			std::string valueStr;
-			while((c = dbFile.get()) != '\0')
+	// Hash tables: one pointer per bucket, nodes hold a next pointer and the element (plus the cached hash for string_view keys).
+	// A posting list with a single bucket uses the bucket embedded in the set itself.
+	usage.dictionaryTokens.count = dbDictionary.size();
+	usage.dictionaryTokens.bytes = dbDictionary.bucket_count() * sizeof(void*)
+		+ dbDictionary.size() * (sizeof(void*) + sizeof(DatabaseDictionary::value_type) + sizeof(std::size_t));
+	for(const auto& [subKey, postings] : dbDictionary)
+	{
+		usage.dictionaryPostings.count += postings.size();
+		usage.dictionaryPostings.bytes += (postings.bucket_count() > 1 ? postings.bucket_count() * sizeof(void*) : 0)
+			+ postings.size() * (sizeof(void*) + sizeof(std::size_t));
+	}
+
+	usage.totalBytes = usage.entries.bytes + usage.arena.bytes + usage.values.bytes + usage.dictionaryTokens.bytes + usage.dictionaryPostings.bytes;
+}
+
+uint64_t DbLoader::getValuesBytes(const DbTypeEnum& type, const DbValues& values, bool isOwningStrings)
+{
+	// make_shared puts the control block (2 counters and a vtable pointer) next to the vector.
+	// std::any keeps integers inside itself, a std::string_view does not fit and is allocated on the heap.
+	uint64_t bytes = 16 + sizeof(DbValues) + values.capacity() * sizeof(std::any);
+	if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
+	{
+		bytes += values.size() * sizeof(std::string_view);
+		if(isOwningStrings)
+		{
+			// The text of OwnedStringValues holds every sub-string followed by the whole string
+			bytes += sizeof(std::string) + 1;
+			for(const auto& v : values)
 			{
-				payload.push_back(c);
-				valueStr += c;
-				++i;
+				const auto* str = std::any_cast<std::string_view>(&v);
+				bytes += str ? str->size() : 0;
 			}
-			++i;
-			payload.push_back(c);
+		}
+	}
+	return bytes;
+}
 
-			// Tokenize the "value" string
-			if(newEntry.type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
-			{
-				// Sanity check, "value" will have two double-quote
-				if(valueStr.length() < 2 || valueStr.front() != '\"' || valueStr.back() != '\"')
-				{
-					TPT_TRACE(TRACE_ERROR, SSTR("Value field of this DB Entry too short or not in correct format: ", valueStr));
-					dbFile.close();
-					return false;
-				}
+std::shared_ptr<const DbLoader::DbValues> DbLoader::makeOwnedStringValues(const std::vector<std::string_view>& subStrings, std::string_view wholeString)
+{
+	auto ownedValues = std::make_shared<OwnedStringValues>();
+	std::size_t length = wholeString.size();
+	for(const auto& subString : subStrings) length += subString.size();
+
+	// Reserved once, so the views below never see the text move
+	std::string& text = ownedValues->text;
+	text.reserve(length);
+	for(const auto& subString : subStrings) text += subString;
+	text += wholeString;
+
+	std::size_t offset = 0;
+	ownedValues->values.reserve(subStrings.size() + 1);
+	for(const auto& subString : subStrings)
+	{
+		ownedValues->values.emplace_back(std::string_view(text).substr(offset, subString.size()));
+		offset += subString.size();
+	}
+	ownedValues->values.emplace_back(std::string_view(text).substr(offset));
 
-				// Remove those two double quotes
-				std::string trimmedValue(valueStr.begin() + 1, valueStr.begin() + valueStr.length() - 1);
+	// Aliasing constructor: the values keep the whole OwnedStringValues alive
+	return std::shared_ptr<const DbValues>(ownedValues, &ownedValues->values);
+}
 
-				std::vector<std::string> values = tokenize(trimmedValue, " ");
-				for(const auto& v : values)
-				{
-					newEntry.values.emplace_back(v);
-				}
-				newEntry.values.emplace_back(trimmedValue);
-			}
-			else
-			{
-				std::vector<std::string> values = tokenize(valueStr, ",");
-				for(const auto& v : values)
-				{
-					int base = 10;
-					// Value is in hex format
-					if(v.find("0x") != std::string::npos)
-					{
-						base = 16;
-					}
+bool DbLoader::loadDb(const std::string& binFilePath)
+{
+	const uint64_t startNs = DbStats::now();
+	std::ifstream dbFile(binFilePath, std::ifstream::binary | std::ifstream::ate);
+	if(!dbFile.is_open())
+	{
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", binFilePath);
+		return false;
+	}
 
-					try
-					{
-						std::size_t pos {};
-						auto numeric = std::stoll(v, &pos, base);
-						if(pos < v.length())
-						{
-							TPT_TRACE(TRACE_ERROR, SSTR("Failed to convert DB value into numeric: ", v));
-						}
-						else if(!isFitIntegralType(numeric, newEntry.type))
-						{
-							TPT_TRACE(TRACE_ERROR, SSTR("DB Value is out of range: ", v, ", compared to type ", newEntry.type.toString()));
-						}
-						else
-						{
-							switch (newEntry.type.getRawEnum())
-							{
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U8:
-								newEntry.values.emplace_back((uint8_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S8:
-								newEntry.values.emplace_back((int8_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U16:
-								newEntry.values.emplace_back((uint16_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S16:
-								newEntry.values.emplace_back((int16_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
-								newEntry.values.emplace_back((uint32_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
-								newEntry.values.emplace_back((int32_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U64:
-								newEntry.values.emplace_back((uint64_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S64:
-								newEntry.values.emplace_back((int64_t)numeric);
-								break;
-							default:
-								break;
-							}
-						}
-					}
-					catch(const std::exception& e)
-					{
-						TPT_TRACE(TRACE_ERROR, SSTR("Raised an exception: ", e.what()));
-					}
-				}
-			}
+	// One read of the whole file, the image is parsed in memory like an embedded one
+	std::vector<char> image(dbFile.tellg());
+	dbFile.seekg(0);
+	if(!dbFile.read(image.data(), image.size()))
+	{
+		DB_TRACE(TRACE_ERROR, "Could not read DB binary file ", binFilePath);
+		dbFile.close();
+		return false;
+	}
+	dbFile.close();
+	m_loadStats.fileReadNs = DbStats::now() - startNs;
 
-			std::scoped_lock<std::mutex> lockStorage(m_storageMutex);
-			std::scoped_lock<std::mutex> lockDictionary(m_dictionaryMutex);
-			m_dbStorage.emplace_back(newEntry);
+	return loadDbImage(std::string_view(image.data(), image.size()), false);
+}
 
-			// Tokenize the key into sub-keys, convenient for searching later (technique: Inverted Index - Hashing Dictionary)
-			std::vector<std::string> subKeys = tokenize(newEntry.key, "/");
-			for(const auto& sk : subKeys)
-			{
-				m_dbDictionary[sk].insert(m_dbStorage.size() - 1); // Storing the index of entry in m_dbStorage vector
-			}
-		}
+bool DbLoader::loadDbImage(std::string_view image, bool isStatic)
+{
+	uint64_t startNs = DbStats::now();
+
+	// Header Tag, Revision, 4 bytes of DB parameters and 4 bytes of payload size, then the payload, End Tag and CRC16
+	if(image.size() < 13)
+	{
+		DB_TRACE(TRACE_ERROR, "The DB image of ", image.size(), " bytes is too short");
+		return false;
+	}
+
+	// DB Header Tag check
+	if(image[0] != 'H')
+	{
+		DB_TRACE(TRACE_ERROR, "The DB Header Tag 'H' was not correct ", std::string(1, image[0]));
+		return false;
+	}
+
+	// DB Revision check, revision 10 has values inlined in each entry, revision 11 has a shared value pool
+	const char dbRevision = image[1];
+	if(dbRevision != DB_REVISION_INLINE_VALUES && dbRevision != DB_REVISION_VALUE_POOL)
+	{
+		DB_TRACE(TRACE_ERROR, "The DB Revision '", (int)dbRevision, "' is not supported");
+		return false;
+	}
+	m_loadStats.dbRevision = dbRevision;
+
+	// Read 4 reserved bytes of DB parameters, in revision 11 they hold the number of bytes of entries placed before the value pool
+	uint8_t buff[4];
+	std::memcpy(buff, image.data() + 2, 4);
+	uint32_t totalEntryBytes = be32toh(*(uint32_t *)buff);
+
+	// Read 4 bytes of total number bytes of DB entries (payload)
+	std::memcpy(buff, image.data() + 6, 4);
+	uint32_t totalPayloadBytes = be32toh(*(uint32_t *)buff); // When converting text-based DB file into binary file, we used Big Endian
+	DB_TRACE(TRACE_INFO, "Total DB entry's payload size: ", totalPayloadBytes, " bytes!");
+
+	if(dbRevision == DB_REVISION_INLINE_VALUES)
+	{
+		totalEntryBytes = totalPayloadBytes;
+	}
+	else if(totalEntryBytes > totalPayloadBytes)
+	{
+		DB_TRACE(TRACE_ERROR, "The DB entries size ", totalEntryBytes, " exceeds the payload size ", totalPayloadBytes);
+		return false;
 	}
 
+	if(image.size() - 13 < totalPayloadBytes)
+	{
+		DB_TRACE(TRACE_ERROR, "The DB payload was truncated, expected ", totalPayloadBytes, " bytes!");
+		return false;
+	}
+	const std::string_view payload = image.substr(10, totalPayloadBytes);
+
 	// Check DB End tag
-	c = dbFile.get();
+	const char c = image[10 + totalPayloadBytes];
 	if(c != 'E')
 	{
-		TPT_TRACE(TRACE_ERROR, SSTR("The DB End Tag 'E' was not correct, char = ", (int)c));
-		dbFile.close();
+		DB_TRACE(TRACE_ERROR, "The DB End Tag 'E' was not correct, char = ", (int)c);
 		return false;
 	}
 
-	// CRC16 checksum
-	for(int i = 0; i < 2; ++i) buff[i] = dbFile.get();
+	// CRC16 checksum, verified before anything is inserted into the Original DB
+	std::memcpy(buff, image.data() + 10 + totalPayloadBytes + 1, 2);
+	m_loadStats.fileBytes = 10 + totalPayloadBytes + 3; // Header, payload, End tag and CRC16
+	m_loadStats.fileReadNs += DbStats::now() - startNs;
+
+	startNs = DbStats::now();
 	uint16_t crc16 = be16toh(*(uint16_t *)buff);
 	uint16_t calculatedCrc16 = getCRC16((uint8_t *)payload.data(), payload.size());
 	if(crc16 != calculatedCrc16)
 	{
-		TPT_TRACE(TRACE_ERROR, SSTR("The DB CRC16 checksum was not correct, origin crc16 = ", crc16, ", calculated crc16 = ", calculatedCrc16));
-		dbFile.close();
-		return false;
+		DB_TRACE(TRACE_ERROR, "The DB CRC16 checksum was not correct, origin crc16 = ", crc16, ", calculated crc16 = ", calculatedCrc16);
+		return false;
+	}
+	m_loadStats.checksum = getContentHash((const uint8_t *)payload.data(), payload.size());
+	m_loadStats.crcNs = DbStats::now() - startNs;
+
+	std::string_view entries = payload.substr(0, totalEntryBytes);
+	std::string_view valuePool = payload.substr(totalEntryBytes);
+	return parseDbEntries(entries, valuePool, dbRevision == DB_REVISION_VALUE_POOL, isStatic);
+}
+
+bool DbLoader::parseDbEntries(std::string_view entries, std::string_view valuePool, bool hasValuePool, bool isStatic)
+{
+	// Identical values of the same type are parsed only once and shared by all of their entries
+	std::unordered_map<int32_t, std::unordered_map<std::string_view, std::shared_ptr<const DbValues>>> sharedValues;
+
+	std::scoped_lock<std::shared_mutex> lockStorage(m_storageMutex);
+	std::scoped_lock<std::shared_mutex> lockDictionary(m_dictionaryMutex);
+
+	// The load profile splits every entry into key parsing, value conversion and dictionary insertion
+	uint64_t phaseStartNs = DbStats::now();
+	const auto endPhase = [&phaseStartNs](uint64_t& phaseNs){
+		const uint64_t nowNs = DbStats::now();
+		phaseNs += nowNs - phaseStartNs;
+		phaseStartNs = nowNs;
+	};
+
+	std::size_t pos = 0;
+	while(pos < entries.length())
+	{
+		if(entries[pos++] != 'F') continue;
+
+		// Start a new entry
+		DbEntry newEntry;
+
+		// Read the "key" in null-terminated string format, followed by 1 byte of "permission" and 1 byte of "type"
+		std::size_t end = entries.find('\0', pos);
+		if(end == std::string_view::npos || end + 2 >= entries.length())
+		{
+			DB_TRACE(TRACE_ERROR, "DB Entry at payload offset ", pos, " was truncated");
+			return false;
+		}
+		std::string_view keyStr = entries.substr(pos, end - pos);
+		pos = end + 1;
+
+		if(!parsePermission(entries[pos++], newEntry.permission) || !parseType(entries[pos++], newEntry.type))
+		{
+			return false;
+		}
+
+		std::string_view valueStr;
+		if(hasValuePool)
+		{
+			// Read 4 bytes of the "value" offset in the value pool, the value there is in null-terminated string format
+			if(pos + 4 > entries.length())
+			{
+				DB_TRACE(TRACE_ERROR, "Value offset of DB Entry ", keyStr, " was truncated");
+				return false;
+			}
+
+			uint8_t buff[4];
+			std::memcpy(buff, entries.data() + pos, 4);
+			uint32_t valueOffset = be32toh(*(uint32_t *)buff);
+			pos += 4;
+
+			end = valueOffset < valuePool.length() ? valuePool.find('\0', valueOffset) : std::string_view::npos;
+			if(end == std::string_view::npos)
+			{
+				DB_TRACE(TRACE_ERROR, "Value offset ", valueOffset, " of DB Entry ", keyStr, " is out of the value pool");
+				return false;
+			}
+			valueStr = valuePool.substr(valueOffset, end - valueOffset);
+		}
+		else
+		{
+			// Read the "value" in null-terminated string format
+			end = entries.find('\0', pos);
+			if(end == std::string_view::npos)
+			{
+				DB_TRACE(TRACE_ERROR, "Value of DB Entry ", keyStr, " was truncated");
+				return false;
+			}
+			valueStr = entries.substr(pos, end - pos);
+			pos = end + 1;
+		}
+
+		// Keys of an embedded image are used in place, they live as long as the process
+		newEntry.key = isStatic ? keyStr : m_dbArena.intern(keyStr);
+		endPhase(m_loadStats.keyParsingNs);
+
+		auto& sharedValue = sharedValues[newEntry.type.toS32()][valueStr];
+		if(!sharedValue)
+		{
+			DbValues values;
+			if(!parseValues(newEntry.type, valueStr, m_dbArena, values))
+			{
+				return false;
+			}
+			sharedValue = std::make_shared<const DbValues>(std::move(values));
+			++m_loadStats.numberOfUniqueValues;
+		}
+		newEntry.values = sharedValue;
+		newEntry.id = m_dbStorage.size();
+		m_dbStorage.emplace_back(newEntry);
+		endPhase(m_loadStats.valueConversionNs);
+
+		// Tokenize the key into sub-keys, convenient for searching later (technique: Inverted Index - Hashing Dictionary)
+		addToDictionary(newEntry.key, m_dbStorage.size() - 1, m_dbDictionary);
+		m_keyIndex.insert(newEntry.key, m_dbStorage.size() - 1);
+		endPhase(m_loadStats.dictionaryNs);
+	}
+
+	attachScalarSlots();
+
+	m_entryVersions = std::make_unique<std::atomic<uint64_t>[]>(m_dbStorage.size());
+	for(std::size_t i = 0; i < m_dbStorage.size(); ++i)
+	{
+		m_dbStorage[i].version = &m_entryVersions[i];
+	}
+
+	m_tokenFilter.reset(m_dbDictionary.size());
+	for(const auto& [token, postings] : m_dbDictionary)
+	{
+		m_tokenFilter.insert(token);
 	}
+	endPhase(m_loadStats.dictionaryNs);
+	DB_TRACE(TRACE_INFO, "Sub-key filter: ", m_tokenFilter.getNumberOfBytes(), " bytes for ", m_dbDictionary.size(), " sub-keys, ",
+		m_tokenFilter.getFalsePositiveRate(m_dbDictionary.size()) * 100, " % false positives expected");
 
-	dbFile.close();
+	m_loadStats.numberOfEntries = m_dbStorage.size();
 	return true;
 }
 
@@ -288,15 +686,26 @@ bool DbLoader::loadHardSavedDb(const std::string& binFilePath)
 	std::ifstream dbFile(binFilePath, std::ifstream::binary);
 	if(!dbFile.is_open())
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", binFilePath));
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", binFilePath);
 		return false;
 	}
 
 	// Read 4 bytes of total number of entries
 	uint8_t buff[4];
 	for(int i = 0; i < 4; ++i) buff[i] = dbFile.get();
+	if(!dbFile)
+	{
+		DB_TRACE(TRACE_ABN, "DB binary file ", binFilePath, " is too short, it will be initialised at the first hard write");
+		return false;
+	}
 	uint32_t totalEntries = be32toh(*(uint32_t *)buff); // When converting text-based DB file into binary file, we used Big Endian
-	TPT_TRACE(TRACE_INFO, SSTR("Total number of entries in Hard Saved DB: ", totalEntries, " entries!"));
+	DB_TRACE(TRACE_INFO, "Total number of entries in Hard Saved DB: ", totalEntries, " entries!");
+
+	// Hard writes of this process rewrite the existing file, even if one of its entries cannot be replayed
+	isHardSavedDbFileInit = true;
+
+	std::scoped_lock<std::shared_mutex> lockModStorage(m_modStorageMutex);
+	std::scoped_lock<std::shared_mutex> lockModDictionary(m_modDictionaryMutex);
 
 	char c;
 	// Analyze DB entries
@@ -309,62 +718,15 @@ bool DbLoader::loadHardSavedDb(const std::string& binFilePath)
 			DbEntry newEntry;
 
 			// Read the "key" in null-terminated string format
+			std::string keyStr;
 			while((c = dbFile.get()) != '\0')
 			{
-				newEntry.key += c;
-			}
-
-			// Read 1 byte of "permission"
-			c = dbFile.get();
-			switch (c)
-			{
-			case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_ONLY)):
-				newEntry.permission.set(DbPermissionEnumRaw::PERM_READ_ONLY);
-				break;
-
-			case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_WRITE)):
-				newEntry.permission.set(DbPermissionEnumRaw::PERM_READ_WRITE);
-				break;
-			
-			default:
-				TPT_TRACE(TRACE_ERROR, SSTR("EnumPermission of this DB Entry was not recognized, ", (int)c));
-				dbFile.close();
-				return false;
+				keyStr += c;
 			}
 
-			// Read 1 byte of "type"
-			c = dbFile.get();
-			switch (c)
+			// Read 1 byte of "permission" and 1 byte of "type"
+			if(!parsePermission(dbFile.get(), newEntry.permission) || !parseType(dbFile.get(), newEntry.type))
 			{
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U8)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U8);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S8)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S8);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U16)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U16);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S16)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S16);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U32)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U32);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S32)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S32);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U64)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U64);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S64)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S64);
-				break;
-			case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)):
-				newEntry.type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR);
-				break;
-			default:
-				TPT_TRACE(TRACE_ERROR, SSTR("EnumType of this DB Entry was not recognized, ", (int)c));
 				dbFile.close();
 				return false;
 			}
@@ -376,105 +738,208 @@ bool DbLoader::loadHardSavedDb(const std::string& binFilePath)
 				valueStr += c;
 			}
 
-			// Tokenize the "value" string
+			// Files written before CHAR values were quoted hold the bare string
+			if(newEntry.type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR && (valueStr.length() < 2 || valueStr.front() != '\"' || valueStr.back() != '\"'))
+			{
+				valueStr = '\"' + valueStr + '\"';
+			}
+
+			// CHAR values are parsed into a scratch arena, the entry then owns its strings like the ones written at runtime
+			StringArena scratchArena;
+			DbValues values;
+			if(!parseValues(newEntry.type, valueStr, scratchArena, values))
+			{
+				dbFile.close();
+				return false;
+			}
 			if(newEntry.type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
 			{
-				// Sanity check, "value" will have two double-quote
-				if(valueStr.length() < 2 || valueStr.front() != '\"' || valueStr.back() != '\"')
-				{
-					TPT_TRACE(TRACE_ERROR, SSTR("Value field of this DB Entry too short or not in correct format: ", valueStr));
-					dbFile.close();
-					return false;
-				}
+				std::vector<std::string_view> subStrings;
+				for(std::size_t i = 0; i + 1 < values.size(); ++i) subStrings.push_back(std::any_cast<std::string_view>(values[i]));
+				newEntry.values = makeOwnedStringValues(subStrings, std::any_cast<std::string_view>(values.back()));
+			}
+			else newEntry.values = std::make_shared<const DbValues>(std::move(values));
 
-				// Remove those two double quotes
-				std::string trimmedValue(valueStr.begin() + 1, valueStr.begin() + valueStr.length() - 1);
+			newEntry.key = m_modDbArena.intern(keyStr);
 
-				std::vector<std::string> values = tokenize(trimmedValue, " ");
-				for(const auto& v : values)
+			// The hard-saved value replaces the one of the Original DB entry in its slot
+			if(const auto index = m_keyIndex.find(newEntry.key); index.has_value())
+			{
+				const DbEntry& originalEntry = m_dbStorage[index.value()];
+				newEntry.version = originalEntry.version;
+				newEntry.id = originalEntry.id;
+				m_hardSavedIds.push_back(newEntry.id);
+				if(originalEntry.scalar)
 				{
-					newEntry.values.emplace_back(v);
+					const auto scalar = newEntry.type == originalEntry.type ? getScalarValue(newEntry) : std::nullopt;
+					newEntry.scalar = originalEntry.scalar;
+					newEntry.scalar->word.store(ScalarSlot::IS_MODIFIED | (scalar.has_value() ? scalar.value() : ScalarSlot::IS_DETACHED),
+						std::memory_order_relaxed);
 				}
-				newEntry.values.emplace_back(trimmedValue);
 			}
 			else
 			{
-				std::vector<std::string> values = tokenize(valueStr, ",");
-				for(const auto& v : values)
-				{
-					int base = 10;
-					// Value is in hex format
-					if(v.find("0x") != std::string::npos)
-					{
-						base = 16;
-					}
-
-					try
-					{
-						std::size_t pos {};
-						auto numeric = std::stoll(v, &pos, base);
-						if(pos < v.length())
-						{
-							TPT_TRACE(TRACE_ERROR, SSTR("Failed to convert DB value into numeric: ", v));
-						}
-						else if(!isFitIntegralType(numeric, newEntry.type))
-						{
-							TPT_TRACE(TRACE_ERROR, SSTR("DB Value is out of range: ", v, ", compared to type ", newEntry.type.toString()));
-						}
-						else
-						{
-							switch (newEntry.type.getRawEnum())
-							{
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U8:
-								newEntry.values.emplace_back((uint8_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S8:
-								newEntry.values.emplace_back((int8_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U16:
-								newEntry.values.emplace_back((uint16_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S16:
-								newEntry.values.emplace_back((int16_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
-								newEntry.values.emplace_back((uint32_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
-								newEntry.values.emplace_back((int32_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_U64:
-								newEntry.values.emplace_back((uint64_t)numeric);
-								break;
-							case DbTypeEnumRaw::TYPE_OF_ENTRY_S64:
-								newEntry.values.emplace_back((int64_t)numeric);
-								break;
-							default:
-								break;
-							}
-						}
-					}
-					catch(const std::exception& e)
-					{
-						TPT_TRACE(TRACE_ERROR, SSTR("Raised an exception: Failed to convert value: \'", v, "\', e.what(): ", e.what()));
-					}
-				}
+				newEntry.id = m_dbStorage.size() + m_numberOfHardSavedOnlyIds++;
+				m_modKeyIndex.hardSavedOnlyIds[newEntry.key] = newEntry.id;
 			}
-
-			std::scoped_lock<std::mutex> lockModStorage(m_modStorageMutex);
-			std::scoped_lock<std::mutex> lockModDictionary(m_modDictionaryMutex);
 			m_modDbStorage.emplace_back(newEntry);
 
 			// Tokenize the key into sub-keys, convenient for searching later (technique: Inverted Index - Hashing Dictionary)
-			std::vector<std::string> subKeys = tokenize(newEntry.key, "/");
-			for(const auto& sk : subKeys)
+			addToDictionary(newEntry.key, m_modDbStorage.size() - 1, m_modDbDictionary);
+			m_modKeyIndex.indexById[newEntry.id] = m_modDbStorage.size() - 1;
+		}
+	}
+
+	dbFile.close();
+	return true;
+}
+
+bool DbLoader::parsePermission(char c, DbPermissionEnum& permission)
+{
+	switch (c)
+	{
+	case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_ONLY)):
+		permission.set(DbPermissionEnumRaw::PERM_READ_ONLY);
+		return true;
+
+	case static_cast<char>(toUnderlyingType(DbPermissionEnumRaw::PERM_READ_WRITE)):
+		permission.set(DbPermissionEnumRaw::PERM_READ_WRITE);
+		return true;
+	
+	default:
+		DB_TRACE(TRACE_ERROR, "EnumPermission of this DB Entry was not recognized, ", (int)c);
+		return false;
+	}
+}
+
+bool DbLoader::parseType(char c, DbTypeEnum& type)
+{
+	switch (c)
+	{
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U8)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U8);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S8)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S8);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U16)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U16);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S16)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S16);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U32)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U32);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S32)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S32);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_U64)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_U64);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_S64)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_S64);
+		return true;
+	case static_cast<char>(toUnderlyingType(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)):
+		type.set(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR);
+		return true;
+	default:
+		DB_TRACE(TRACE_ERROR, "EnumType of this DB Entry was not recognized, ", (int)c);
+		return false;
+	}
+}
+
+bool DbLoader::parseValues(const DbTypeEnum& type, std::string_view valueStr, StringArena& arena, DbValues& values)
+{
+	// Tokenize the "value" string
+	if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
+	{
+		// Sanity check, "value" will have two double-quote
+		if(valueStr.length() < 2 || valueStr.front() != '\"' || valueStr.back() != '\"')
+		{
+			DB_TRACE(TRACE_ERROR, "Value field of this DB Entry too short or not in correct format: ", valueStr);
+			return false;
+		}
+
+		// Remove those two double quotes, then intern the whole string only once.
+		// The split values are views into the interned whole string, so they cost no extra copy.
+		std::string_view trimmedValue = arena.intern(valueStr.substr(1, valueStr.length() - 2));
+
+		forEachToken(trimmedValue, ' ', [&values](std::string_view v){
+			values.emplace_back(v);
+			return true;
+		});
+		values.emplace_back(trimmedValue);
+		return true;
+	}
+
+	std::vector<std::string_view> tokens = tokenize(valueStr, ',');
+	values.reserve(tokens.size());
+	for(const auto& token : tokens)
+	{
+		const std::string v(token);
+		int base = 10;
+		// Value is in hex format
+		if(v.find("0x") != std::string::npos)
+		{
+			base = 16;
+		}
+
+		try
+		{
+			std::size_t pos {};
+			++m_loadStats.numberOfConversions;
+			auto numeric = std::stoll(v, &pos, base);
+			if(pos < v.length())
+			{
+				DB_TRACE(TRACE_ERROR, "Failed to convert DB value into numeric: ", v);
+				++m_loadStats.numberOfConversionFailures;
+			}
+			else if(!isFitIntegralType(numeric, type))
 			{
-				m_modDbDictionary[sk].insert(m_modDbStorage.size() - 1); // Storing the index of entry in m_dbStorage vector
+				DB_TRACE(TRACE_ERROR, "DB Value is out of range: ", v, ", compared to type ", type.toString());
+				++m_loadStats.numberOfConversionFailures;
+			}
+			else
+			{
+				switch (type.getRawEnum())
+				{
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_U8:
+					values.emplace_back((uint8_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_S8:
+					values.emplace_back((int8_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_U16:
+					values.emplace_back((uint16_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_S16:
+					values.emplace_back((int16_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
+					values.emplace_back((uint32_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
+					values.emplace_back((int32_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_U64:
+					values.emplace_back((uint64_t)numeric);
+					break;
+				case DbTypeEnumRaw::TYPE_OF_ENTRY_S64:
+					values.emplace_back((int64_t)numeric);
+					break;
+				default:
+					break;
+				}
 			}
 		}
+		catch(const std::exception& e)
+		{
+			DB_TRACE(TRACE_ERROR, "Raised an exception: Failed to convert value: \'", v, "\', e.what(): ", e.what());
+			++m_loadStats.numberOfConversionFailures;
+		}
 	}
 
-	dbFile.close();
 	return true;
 }
 
@@ -508,157 +973,434 @@ bool DbLoader::isFitIntegralType(const int64_t& valueToCheck, const DbTypeEnum&
 		{
 			isFit = true;
 		}
-	}
-	if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_U32)
-	{
-		if(valueToCheck <= std::numeric_limits<uint32_t>::max() && valueToCheck >= std::numeric_limits<uint32_t>::min())
+	}
+	if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_U32)
+	{
+		if(valueToCheck <= std::numeric_limits<uint32_t>::max() && valueToCheck >= std::numeric_limits<uint32_t>::min())
+		{
+			isFit = true;
+		}
+	}
+	else if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_S32)
+	{
+		if(valueToCheck <= std::numeric_limits<int32_t>::max() && valueToCheck >= std::numeric_limits<int32_t>::min())
+		{
+			isFit = true;
+		}
+	}
+	else if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_U64)
+	{
+		isFit = valueToCheck >= 0;
+	}
+	else if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_S64)
+	{
+		isFit = true; // Every value parsed by std::stoll() fits
+	}
+
+	return isFit;
+}
+
+std::vector<std::string_view> DbLoader::tokenize(std::string_view str, char delimiter)
+{
+	std::vector<std::string_view> tokens;
+	tokens.reserve(10);
+
+	forEachToken(str, delimiter, [&tokens](std::string_view token){
+		tokens.emplace_back(token);
+		return true;
+	});
+
+	return tokens;
+}
+
+void DbLoader::addToDictionary(std::string_view key, std::size_t index, DatabaseDictionary& dbDictionary)
+{
+	// Sub-keys are views into the interned key, the dictionary never owns a copy of them
+	forEachToken(key, '/', [&dbDictionary, index](std::string_view subKey){
+		dbDictionary[subKey].insert(index); // Storing the index of entry in the storage vector
+		return true;
+	});
+}
+
+std::vector<std::size_t> DbLoader::findMatchingKeys(std::string_view input, const DatabaseDictionary& dbDictionary, std::shared_mutex& mtx)
+{
+	auto lockDictionary = m_stats.lockShared(mtx);
+	if(dbDictionary.empty())
+	{
+		// DB_TRACE(TRACE_ABN, "The DB Dictionary is empty!");
+		return {};
+	}
+
+	std::unordered_set<std::size_t> intersect;
+	std::unordered_set<std::size_t> tmp;
+	bool isTokenized = false;
+	bool isFirstToken = true;
+	const bool isAllFound = forEachToken(input, '/', [&](std::string_view token){
+		isTokenized = true;
+		auto it = dbDictionary.find(token);
+		if(it == dbDictionary.end())
+		{
+			// DB_TRACE(TRACE_ABN, "Token ", token, " could not be found in dbDictionary!");
+			return false;
+		}
+
+		if(isFirstToken)
+		{
+			isFirstToken = false;
+			intersect = it->second;
+		}
+		else
+		{
+			// std::set_intersection() requires sorted ranges, which unordered sets are not, so probe the posting list instead
+			tmp.clear();
+			for(const auto& index : intersect)
+			{
+				if(it->second.count(index)) tmp.insert(index);
+			}
+			intersect.swap(tmp);
+		}
+
+		return !intersect.empty(); // No need to look at the remaining tokens once nothing matches anymore
+	});
+
+	if(!isTokenized)
+	{
+		DB_TRACE(TRACE_ABN, "Input key ", input, " cannot be tokenized!");
+		return {};
+	}
+	else if(!isAllFound)
+	{
+		return {};
+	}
+	
+	return {intersect.begin(), intersect.end()};
+}
+
+void DbLoader::attachScalarSlots()
+{
+	m_numberOfScalarSlots = 0;
+	for(const auto& entry : m_dbStorage)
+	{
+		if(getScalarValue(entry).has_value()) ++m_numberOfScalarSlots;
+	}
+
+	m_scalarSlots = std::make_unique<ScalarSlot[]>(m_numberOfScalarSlots);
+	ScalarSlot* slot = m_scalarSlots.get();
+	for(auto& entry : m_dbStorage)
+	{
+		if(const auto scalar = getScalarValue(entry); scalar.has_value())
+		{
+			slot->originalValue = scalar.value();
+			slot->word.store(scalar.value(), std::memory_order_relaxed);
+			entry.scalar = slot++;
+		}
+	}
+
+	DB_TRACE(TRACE_INFO, m_numberOfScalarSlots, " of ", m_dbStorage.size(), " entries are scalars with an atomic slot");
+}
+
+std::optional<uint32_t> DbLoader::getScalarValue(const DbEntry& entry)
+{
+	if(!entry.values || entry.values->size() != 1 || !entry.values->front().has_value()) return std::nullopt;
+
+	const std::any& v = entry.values->front();
+	switch (entry.type.getRawEnum())
+	{
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U8:
+		return std::any_cast<uint8_t>(v);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S8:
+		return static_cast<uint32_t>(std::any_cast<int8_t>(v));
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U16:
+		return std::any_cast<uint16_t>(v);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S16:
+		return static_cast<uint32_t>(std::any_cast<int16_t>(v));
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
+		return std::any_cast<uint32_t>(v);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
+		return static_cast<uint32_t>(std::any_cast<int32_t>(v));
+	default:
+		return std::nullopt;
+	}
+}
+
+std::any DbLoader::makeScalarValue(const DbTypeEnum& type, uint32_t value)
+{
+	switch (type.getRawEnum())
+	{
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U8:
+		return static_cast<uint8_t>(value);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S8:
+		return static_cast<int8_t>(value);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U16:
+		return static_cast<uint16_t>(value);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S16:
+		return static_cast<int16_t>(value);
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
+		return value;
+	case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
+		return static_cast<int32_t>(value);
+	default:
+		return std::any();
+	}
+}
+
+bool DbLoader::mayBeFound(std::string_view key)
+{
+	// Every sub-key of a matching key is in the dictionary, so a single sub-key missing in the filter is a definite miss.
+	// This holds for partial keys too, which a filter over whole keys could not reject.
+	const bool isMaybeFound = forEachToken(key, '/', [this](std::string_view token){
+		return m_tokenFilter.mayContain(token);
+	});
+
+	if(!isMaybeFound) m_stats.count(DbStats::Counter::FILTER_REJECTS);
+	return isMaybeFound;
+}
+
+std::optional<std::pair<std::size_t, bool>> DbLoader::findWholeKey(std::string_view key, const ModifiedKeyIndex& modKeyIndex) const
+{
+	// A whole key is found in the radix tree with one walk over its bytes and never matches another key made of the same tokens
+	std::optional<uint32_t> id = m_keyIndex.find(key);
+	if(!id.has_value())
+	{
+		if(modKeyIndex.hardSavedOnlyIds.empty()) return std::nullopt;
+
+		const auto it = modKeyIndex.hardSavedOnlyIds.find(key);
+		if(it == modKeyIndex.hardSavedOnlyIds.end()) return std::nullopt;
+		id = it->second;
+	}
+
+	// The id of an Original DB entry is its index
+	if(const auto it = modKeyIndex.indexById.find(id.value()); it != modKeyIndex.indexById.end()) return std::make_pair(it->second, true);
+	return std::make_pair(static_cast<std::size_t>(id.value()), false);
+}
+
+std::optional<std::pair<std::size_t, bool>> DbLoader::findPrefixFallback(std::string_view key, const ModifiedKeyIndex& modKeyIndex) const
+{
+	// A key which is in no entry, e.g. a board specific /hw/x/fanSpeed/board7, falls back to the longest whole key it continues
+	// by sub-keys (/hw/x/fanSpeed), so that one generic entry serves all boards without an entry of their own
+	const auto prefix = m_keyIndex.findLongestPrefix(key, '/');
+	if(!prefix.has_value()) return std::nullopt;
+
+	return findWholeKey(key.substr(0, prefix->first), modKeyIndex);
+}
+
+std::optional<std::pair<std::size_t, bool>> DbLoader::findMatchingIndices(std::string_view input, bool isPrefixFallback)
+{
+	{
+		auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+		if(const auto wholeKey = findWholeKey(input, m_modKeyIndex); wholeKey.has_value())
+		{
+			m_stats.count(wholeKey->second ? DbStats::Counter::MODIFIED_DB_HITS : DbStats::Counter::ORIGINAL_DB_HITS);
+			return wholeKey;
+		}
+	}
+
+	// Only partial keys need the token dictionaries, first try seeking on Modified Database
+	auto indices = findMatchingKeys(input, m_modDbDictionary, m_modDictionaryMutex);
+	if(indices.empty())
+	{
+		// DB_TRACE(TRACE_INFO, "DB key ", input, " could not be found in Modified DB, try on Original DB!");
+		// Keys with a sub-key which is in no entry are rejected by the filter before probing the dictionary
+		if(mayBeFound(input))
+		{
+			indices = findMatchingKeys(input, m_dbDictionary, m_dictionaryMutex);
+			if(indices.empty()) m_stats.count(DbStats::Counter::FILTER_FALSE_POSITIVES);
+		}
+
+		if(indices.empty() && isPrefixFallback)
+		{
+			auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+			if(const auto fallback = findPrefixFallback(input, m_modKeyIndex); fallback.has_value())
+			{
+				m_stats.count(fallback->second ? DbStats::Counter::MODIFIED_DB_HITS : DbStats::Counter::ORIGINAL_DB_HITS);
+				return fallback;
+			}
+		}
+
+		if(indices.empty())
+		{
+			DB_TRACE(TRACE_ABN, "DB key ", input, " could not be found even in Original DB!");
+			return std::nullopt;
+		}
+		else if(indices.size() > 1)
 		{
-			isFit = true;
+			DB_TRACE(TRACE_ABN, "Found ", indices.size(), " matching keys (\"", input,"\"): only the first key will be returned which might not be expected!");
 		}
+
+		m_stats.count(DbStats::Counter::ORIGINAL_DB_HITS);
+		return std::make_pair(indices.front(), false);
 	}
-	else if(type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_S32)
+	else if(indices.size() > 1)
 	{
-		if(valueToCheck <= std::numeric_limits<int32_t>::max() && valueToCheck >= std::numeric_limits<int32_t>::min())
-		{
-			isFit = true;
-		}
+		DB_TRACE(TRACE_ABN, "Found ", indices.size(), " matching keys (\"", input,"\"): only the first key will be returned which might not be expected!");
 	}
 
-	// No need to check int64_t or uint64_t, because it's meaningless
-	return isFit;
+	// Only the first found entry will be returned
+	m_stats.count(DbStats::Counter::MODIFIED_DB_HITS);
+	return std::make_pair(indices.front(), true);
 }
 
-std::vector<std::string> DbLoader::tokenize(const std::string& key, const std::string& delimiter)
+std::optional<std::size_t> DbLoader::findFirstMatchingKey(std::string_view input, const DatabaseDictionary& dbDictionary) const
 {
-	std::vector<std::string> tokens;
-	tokens.reserve(10);
-
-	std::size_t startIndex = 0;
-	std::size_t i;
-	while((i = key.find(delimiter, startIndex)) != std::string::npos)
-	{
-		if(i > startIndex)
-		{
-			std::string newToken = key.substr(startIndex, i - startIndex);
-			newToken.erase(std::remove_if(newToken.begin(), newToken.end(), [](auto& c){
-				return c == ' ' || c == '\t';
-			}), newToken.end());
+	// Same matching as findMatchingKeys() without building the intersection: take the shortest posting list
+	// and return its first index which is also in the posting lists of all other tokens
+	const std::unordered_set<std::size_t>* candidates = nullptr;
+	const bool isAllFound = forEachToken(input, '/', [&](std::string_view token){
+		auto it = dbDictionary.find(token);
+		if(it == dbDictionary.end()) return false;
 
-			if(newToken.length()) tokens.emplace_back(newToken);
-		}
+		if(candidates == nullptr || it->second.size() < candidates->size()) candidates = &it->second;
+		return true;
+	});
 
-		startIndex = i + delimiter.length();
-	}
+	if(!isAllFound || candidates == nullptr) return std::nullopt;
 
-	if(startIndex < key.length())
+	for(const auto& index : *candidates)
 	{
-		std::string newToken = key.substr(startIndex, i - startIndex);
-		newToken.erase(std::remove_if(newToken.begin(), newToken.end(), [](auto& c){
-			return c == ' ' || c == '\t';
-		}), newToken.end());
+		const bool isMatching = forEachToken(input, '/', [&](std::string_view token){
+			const auto& postings = dbDictionary.find(token)->second; // All tokens were found above
+			return &postings == candidates || postings.count(index) > 0;
+		});
 
-		if(newToken.length()) tokens.emplace_back(newToken);
+		if(isMatching) return index;
 	}
 
-	return tokens;
+	return std::nullopt;
 }
 
-std::vector<std::size_t> DbLoader::findMatchingKeys(const std::string& input, const DatabaseDictionary& dbDictionary, std::mutex& mtx)
+ReturnCodeEnum DbLoader::retrieveMany(std::vector<GetRequest>& requests)
 {
-	std::scoped_lock<std::mutex> lockDictionary(mtx);
-	if(dbDictionary.empty())
+	const uint64_t startNs = m_stats.startOperation();
+	ReturnCodeEnum rc(ReturnCodeRaw::OK);
 	{
-		// TPT_TRACE(TRACE_ABN, SSTR("The DB Dictionary is empty!"));
-		return {};
+		// All DB locks at once, in the order writers take them, so that every request sees the same state of the DB
+		// and the batch pays for one acquisition instead of four per key. Shared, so batches do not wait for each other.
+		auto lockModStorage = m_stats.lockShared(m_modStorageMutex);
+		auto lockStorage = m_stats.lockShared(m_storageMutex);
+		auto lockModDictionary = m_stats.lockShared(m_modDictionaryMutex);
+		auto lockDictionary = m_stats.lockShared(m_dictionaryMutex);
+		for(auto& request : requests)
+		{
+			request.rc = std::visit([this, &request](auto* values){
+				return values ? retrieveLockedEntry(request.key, *values) : ReturnCodeEnum(ReturnCodeRaw::UNDEFINED);
+			}, request.values);
+
+			if(request.rc.getRawEnum() != ReturnCodeRaw::OK && rc.getRawEnum() == ReturnCodeRaw::OK) rc = request.rc;
+		}
 	}
+	// Failures of single keys were counted by retrieveLockedEntry()
+	m_stats.endOperation(DbStats::Operation::GET_MANY, startNs, ReturnCodeEnum(ReturnCodeRaw::OK));
 
-	auto tokens = tokenize(input, "/");
-	if(tokens.empty())
+	for(const auto& request : requests)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Input key ", input, " cannot be tokenized!"));
-		return {};
+		if(m_hotKeys.isSampled()) recordHotKey(request.key, request.rc, HotKeyTracker::Access::READ);
 	}
 
-	std::unordered_set<std::size_t> intersect;
-	std::unordered_set<std::size_t> tmp;
-	for(const auto& token : tokens)
+	return rc;
+}
+
+std::size_t DbLoader::scan(std::string_view prefix, const std::function<bool(const ScanEntry&)>& visitor, std::optional<ValueType> type)
+{
+	static_assert(static_cast<int>(ValueType::CHAR) == static_cast<int>(DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR), "ValueType must mirror DbTypeEnumRaw");
+
+	// The Modified DB may change while visiting, so take a sorted copy of its entries under prefix (their values are shared, not copied).
+	// The Original DB and its key index are read without lock, nothing modifies them after load.
+	std::vector<DbEntry> modEntries;
 	{
-		auto it = dbDictionary.find(token);
-		if(it == dbDictionary.end())
+		auto lockModStorage = m_stats.lockShared(m_modStorageMutex);
+		for(const auto& entry : m_modDbStorage)
 		{
-			// TPT_TRACE(TRACE_ABN, SSTR("Token ", token, " could not be found in dbDictionary!"));
-			return {};
+			if(KeyIndex::isUnderPrefix(entry.key, prefix)) modEntries.push_back(entry);
 		}
+	}
+	std::sort(modEntries.begin(), modEntries.end(), [](const DbEntry& lhs, const DbEntry& rhs){ return lhs.key < rhs.key; });
 
-		if(intersect.empty())
+	std::size_t numberOfVisits = 0;
+	DbValues scalarValues(1); // Values of entries with a slot, which may be newer than their values
+	const auto visit = [&](const DbEntry& entry, bool isModified){
+		const auto entryType = static_cast<ValueType>(entry.type.getRawEnum());
+		if(isErased(entry) || (type.has_value() && type.value() != entryType)) return true;
+
+		const DbValues* values = entry.values.get();
+		if(const auto scalar = loadScalar(entry); scalar.has_value())
 		{
-			intersect = it->second;
+			scalarValues.front() = makeScalarValue(entry.type, scalar.value());
+			values = &scalarValues;
 		}
-		else
+
+		++numberOfVisits;
+		return visitor(ScanEntry {entry.key, entryType, isModified, values});
+	};
+
+	// The key index yields the Original DB in key order, merge the Modified DB entries into it (they win over the same key)
+	auto modIt = modEntries.begin();
+	const bool isCompleted = m_keyIndex.forEachWithPrefix(prefix, [&](uint32_t index){
+		const DbEntry& entry = m_dbStorage[index];
+		if(!KeyIndex::isUnderPrefix(entry.key, prefix)) return true; // e.g. /a/bc for the prefix /a/b
+
+		while(modIt != modEntries.end() && modIt->key < entry.key)
 		{
-			tmp.clear();
-			std::set_intersection(intersect.begin(), intersect.end(), (it->second).begin(), (it->second).end(), std::inserter(tmp, tmp.begin()));
-			intersect = tmp;
+			if(!visit(*modIt++, true)) return false;
 		}
+
+		if(modIt != modEntries.end() && modIt->key == entry.key) return visit(*modIt++, true);
+		return visit(entry, false);
+	});
+
+	while(isCompleted && modIt != modEntries.end() && visit(*modIt++, true))
+	{
 	}
-	
-	return {intersect.begin(), intersect.end()};
+
+	return numberOfVisits;
 }
 
-std::optional<std::pair<std::size_t, bool>> DbLoader::findMatchingIndices(const std::string& input)
+bool DbLoader::lockMemory()
 {
-	// First try seeking on Modified Database
-	auto indices = findMatchingKeys(input, m_modDbDictionary, m_modDictionaryMutex);
-	if(indices.empty())
-	{
-		// TPT_TRACE(TRACE_INFO, SSTR("DB key ", input, " could not be found in Modified DB, try on Original DB!"));
-		indices = findMatchingKeys(input, m_dbDictionary, m_dictionaryMutex);
-		if(indices.empty())
-		{
-			TPT_TRACE(TRACE_ABN, SSTR("DB key ", input, " could not be found even in Original DB!"));
-			return std::nullopt;
-		}
-		else if(indices.size() > 1)
-		{
-			TPT_TRACE(TRACE_ABN, SSTR("Found ", indices.size(), " matching keys (\"", input,"\"): only the first key will be returned which might not be expected!"));
-		}
-
-		return std::make_pair(indices.front(), false);
-	}
-	else if(indices.size() > 1)
+	// MCL_FUTURE also covers what is allocated later on, e.g. values of updated entries and stacks of new threads
+	if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Found ", indices.size(), " matching keys (\"", input,"\"): only the first key will be returned which might not be expected!"));
+		DB_TRACE(TRACE_ERROR, "Could not lock the process memory: ", std::strerror(errno));
+		return false;
 	}
 
-	// Only the first found entry will be returned
-	return std::make_pair(indices.front(), true);
+	DB_TRACE(TRACE_INFO, "Locked the process memory, the DB will stay resident");
+	return true;
 }
 
 void DbLoader::updateHardSavedDb(const std::size_t& index)
 {
+	// The file is rewritten under m_hardSaveMutex only, readers and writers of the Modified DB just wait for the entry copy.
+	// Every rewrite copies the latest value, so the last one leaves the file in line with memory whatever order writers come in.
+	std::scoped_lock<std::mutex> lockHardSave(m_hardSaveMutex);
+	applyPendingHardSave();
 	if(!isHardSavedDbFileInit)
 	{
 		isHardSavedDbFileInit = true;
 		initHardSavedDbFile();
 	}
 
-	std::mutex& mtx = m_modStorageMutex;
-	DatabaseStorage& dbStorage = m_modDbStorage;
-
-	std::scoped_lock<std::mutex> lockStorage(mtx);
-	const auto& updatedEntry = dbStorage.at(index);
+	DbEntry updatedEntry;
+	{
+		auto lockStorage = m_stats.lockShared(m_modStorageMutex);
+		updatedEntry = m_modDbStorage.at(index);
+	}
+	// Soft writes since the hard one may only have changed the slot
+	if(const auto scalar = loadScalar(updatedEntry); scalar.has_value())
+	{
+		updatedEntry.values = std::make_shared<const DbValues>(DbValues {makeScalarValue(updatedEntry.type, scalar.value())});
+	}
 
 	std::ifstream inputFile(m_binDbPath + "/swdb-hardsave.bin", std::ifstream::binary);
 	if(!inputFile.is_open())
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.bin"));
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.bin");
 		return;
 	}
 
 	std::ofstream outputFile(m_binDbPath + "/swdb-hardsave.tmp.bin", std::ios_base::binary);
 	if(!outputFile.is_open())
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.tmp.bin"));
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.tmp.bin");
 		inputFile.close();
 		return;
 	}
@@ -709,14 +1451,17 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 
 				if(updatedEntry.type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
 				{
-					for(const auto& ch : std::any_cast<std::string>(updatedEntry.values.back()))
+					// Quoted like in swdb.bin, see parseValues()
+					newContent.emplace_back('\"');
+					for(const auto& ch : std::any_cast<std::string_view>(updatedEntry.values->back()))
 					{
 						newContent.emplace_back(ch);
 					}
+					newContent.emplace_back('\"');
 				}
 				else
 				{
-					for(const auto& v : updatedEntry.values)
+					for(const auto& v : *updatedEntry.values)
 					{
 						std::string str;
 						switch (updatedEntry.type.getRawEnum())
@@ -734,16 +1479,16 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 							str = std::to_string((int)std::any_cast<int16_t>(v));
 							break;
 						case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
-							str = std::to_string((int)std::any_cast<uint32_t>(v));
+							str = std::to_string(std::any_cast<uint32_t>(v));
 							break;
 						case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
 							str = std::to_string((int)std::any_cast<int32_t>(v));
 							break;
 						case DbTypeEnumRaw::TYPE_OF_ENTRY_U64:
-							str = std::to_string((int)std::any_cast<uint64_t>(v));
+							str = std::to_string(std::any_cast<uint64_t>(v));
 							break;
 						case DbTypeEnumRaw::TYPE_OF_ENTRY_S64:
-							str = std::to_string((int)std::any_cast<int64_t>(v));
+							str = std::to_string(std::any_cast<int64_t>(v));
 							break;
 						default:
 							break;
@@ -757,8 +1502,11 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 						newContent.emplace_back(' ');
 					}
 
-					newContent.pop_back(); // Remove redundant of the last ", "
-					newContent.pop_back();
+					if(!updatedEntry.values->empty())
+					{
+						newContent.pop_back(); // Remove redundant of the last ", "
+						newContent.pop_back();
+					}
 				}
 				newContent.emplace_back('\0');
 				found = true;
@@ -800,14 +1548,16 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 
 		if(updatedEntry.type.getRawEnum() == DbTypeEnumRaw::TYPE_OF_ENTRY_CHAR)
 		{
-			for(const auto& ch : std::any_cast<std::string>(updatedEntry.values.back()))
+			newContent.emplace_back('\"');
+			for(const auto& ch : std::any_cast<std::string_view>(updatedEntry.values->back()))
 			{
 				newContent.emplace_back(ch);
 			}
+			newContent.emplace_back('\"');
 		}
 		else
 		{
-			for(const auto& v : updatedEntry.values)
+			for(const auto& v : *updatedEntry.values)
 			{
 				std::string str;
 				switch (updatedEntry.type.getRawEnum())
@@ -825,16 +1575,16 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 					str = std::to_string((int)std::any_cast<int16_t>(v));
 					break;
 				case DbTypeEnumRaw::TYPE_OF_ENTRY_U32:
-					str = std::to_string((int)std::any_cast<uint32_t>(v));
+					str = std::to_string(std::any_cast<uint32_t>(v));
 					break;
 				case DbTypeEnumRaw::TYPE_OF_ENTRY_S32:
 					str = std::to_string((int)std::any_cast<int32_t>(v));
 					break;
 				case DbTypeEnumRaw::TYPE_OF_ENTRY_U64:
-					str = std::to_string((int)std::any_cast<uint64_t>(v));
+					str = std::to_string(std::any_cast<uint64_t>(v));
 					break;
 				case DbTypeEnumRaw::TYPE_OF_ENTRY_S64:
-					str = std::to_string((int)std::any_cast<int64_t>(v));
+					str = std::to_string(std::any_cast<int64_t>(v));
 					break;
 				default:
 					break;
@@ -848,8 +1598,11 @@ void DbLoader::updateHardSavedDb(const std::size_t& index)
 				newContent.emplace_back(' ');
 			}
 
-			newContent.pop_back(); // Remove redundant last ", " 
-			newContent.pop_back();
+			if(!updatedEntry.values->empty())
+			{
+				newContent.pop_back(); // Remove redundant last ", " 
+				newContent.pop_back();
+			}
 		}
 		newContent.emplace_back('\0');
 
@@ -880,7 +1633,7 @@ void DbLoader::initHardSavedDbFile()
 	std::ofstream binFile(m_binDbPath + "/swdb-hardsave.bin", std::ios_base::binary);
 	if(!binFile.is_open())
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not init DB binary file ", m_binDbPath, "/swdb-hardsave.bin"));
+		DB_TRACE(TRACE_ABN, "Could not init DB binary file ", m_binDbPath, "/swdb-hardsave.bin");
 		return;
 	}
 
@@ -911,16 +1664,29 @@ uint16_t DbLoader::getCRC16(uint8_t *startAddr, uint32_t numberBytes)
 	return (tmp ^ 0xFFFF) & 0xFFFF;
 }
 
+uint64_t DbLoader::getContentHash(const uint8_t *startAddr, uint32_t numberBytes)
+{
+	// 64-bit FNV-1a, the same as textToBin writes into generated accessors as DB_CHECKSUM. A CRC16 is too short to tell
+	// DB images apart, one in 65536 other images would pass for the one the accessors were generated from.
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for(const uint8_t *currentAddr = startAddr; currentAddr < startAddr + numberBytes; ++currentAddr)
+	{
+		hash = (hash ^ *currentAddr) * 0x100000001B3ull;
+	}
+
+	return hash;
+}
+
 bool DbLoader::checkIfWritable(const std::size_t& index, const bool& isFoundInModDb)
 {
 	DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
-	std::mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
+	std::shared_mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
 
-	std::scoped_lock<std::mutex> lockStorage(mtx);
+	auto lockStorage = m_stats.lockShared(mtx);
 	auto rc = dbStorage.at(index).permission;
 	if(rc.getRawEnum() == DbPermissionEnumRaw::PERM_READ_ONLY)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("DB key ", dbStorage.at(index).key, " has Read-Only permission!"));
+		DB_TRACE(TRACE_ABN, "DB key ", dbStorage.at(index).key, " has Read-Only permission!");
 		return false;
 	}
 	else if(rc.getRawEnum() == DbPermissionEnumRaw::PERM_READ_WRITE)
@@ -928,80 +1694,199 @@ bool DbLoader::checkIfWritable(const std::size_t& index, const bool& isFoundInMo
 		return true;
 	}
 	
-	TPT_TRACE(TRACE_ABN, SSTR("DB key ", dbStorage.at(index).key, " has Unknown permission!"));
+	DB_TRACE(TRACE_ABN, "DB key ", dbStorage.at(index).key, " has Unknown permission!");
 	return false;
 }
 
-ReturnCodeEnum DbLoader::resetToDefault()
+std::shared_ptr<const DbLoader::Snapshot> DbLoader::takeSnapshot()
 {
-	std::scoped_lock<std::mutex> lockStorage(m_modStorageMutex);
-	m_modDbStorage.clear();
-	std::scoped_lock<std::mutex> lockDictionary(m_modDictionaryMutex);
-	m_modDbDictionary.clear();
+	// Counted before the copy so that reset() keeps m_modDbArena, which the copied keys point into
+	m_numberOfSnapshots.fetch_add(1, std::memory_order_acq_rel);
+	std::shared_ptr<Snapshot> snapshot(new Snapshot, [this](Snapshot* p){
+		delete p;
+		m_numberOfSnapshots.fetch_sub(1, std::memory_order_acq_rel);
+	});
+
+	auto lockModStorage = m_stats.lock(m_modStorageMutex);
+
+	// Locked writers are held off by the mutex, lock-free ones fall back to it once they see the pending flag.
+	// Those already past it finish their slot write (and take their version) before the copy.
+	m_isSnapshotPending.store(true, std::memory_order_seq_cst);
+	while((m_writeSequence.load(std::memory_order_seq_cst) & (VERSION_INCREMENT - 1)) != 0)
+	{
+		std::this_thread::yield();
+	}
 
-	std::remove(std::string(m_binDbPath + "/swdb-hardsave.bin").c_str());
-	initHardSavedDbFile();
-	isHardSavedDbFileInit = true;
+	snapshot->version = getVersion();
+	snapshot->modDbStorage.reserve(m_modDbStorage.size());
+	for(const auto& entry : m_modDbStorage)
+	{
+		DbEntry& copiedEntry = snapshot->modDbStorage.emplace_back(entry);
+		if(const auto scalar = loadScalar(entry); scalar.has_value())
+		{
+			copiedEntry.values = std::make_shared<const DbValues>(DbValues {makeScalarValue(entry.type, scalar.value())});
+		}
+		copiedEntry.scalar = nullptr;
+	}
+	snapshot->erasedWords = m_erasedEntries.copyWords();
+	{
+		auto lockModDictionary = m_stats.lock(m_modDictionaryMutex);
+		snapshot->modDbDictionary = m_modDbDictionary;
+		snapshot->modKeyIndex = m_modKeyIndex;
+	}
+	m_isSnapshotPending.store(false, std::memory_order_release);
 
-	TPT_TRACE(TRACE_INFO, SSTR("Database settings reset to default successfully!"));
-	return ReturnCodeEnum(ReturnCodeRaw::OK);
+	DB_TRACE(TRACE_INFO, "Took snapshot of DB version ", snapshot->version, " with ", snapshot->modDbStorage.size(), " modified entries");
+	return snapshot;
 }
 
-bool DbLoader::checkIfErased(const std::size_t& index, const bool& isFoundInModDb)
+const DbLoader::DbEntry* DbLoader::findSnapshotEntry(const Snapshot& snapshot, std::string_view key)
 {
-	DatabaseStorage& dbStorage = isFoundInModDb ? m_modDbStorage : m_dbStorage;
-	std::mutex& mtx = isFoundInModDb ? m_modStorageMutex : m_storageMutex;
-
-	std::scoped_lock<std::mutex> lockStorage(mtx);
-	if(dbStorage.at(index).status.isErased)
+	// Same lookup as findMatchingIndices(), on the Modified DB copied into the snapshot
+	if(const auto wholeKey = findWholeKey(key, snapshot.modKeyIndex); wholeKey.has_value())
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("DB key ", dbStorage.at(index).key, " was already erased!"));
-		return true;
+		return wholeKey->second ? &snapshot.modDbStorage.at(wholeKey->first) : &m_dbStorage[wholeKey->first];
 	}
 
-	return false;
+	auto indices = findMatchingKeys(key, snapshot.modDbDictionary, snapshot.dictionaryMutex);
+	if(!indices.empty()) return &snapshot.modDbStorage.at(indices.front());
+	else if(mayBeFound(key)) indices = findMatchingKeys(key, m_dbDictionary, m_dictionaryMutex);
+	if(!indices.empty()) return &m_dbStorage.at(indices.front());
+
+	const auto fallback = findPrefixFallback(key, snapshot.modKeyIndex);
+	if(!fallback.has_value()) return nullptr;
+
+	return fallback->second ? &snapshot.modDbStorage.at(fallback->first) : &m_dbStorage[fallback->first];
 }
 
-std::size_t DbLoader::eraseDbEntry(const std::size_t& index, const bool& isFoundInModDb)
+uint64_t DbLoader::getEntryVersion(const std::size_t& index, const bool& isFoundInModDb)
 {
-	std::scoped_lock<std::mutex> lockStorage(m_modStorageMutex);
+	const std::atomic<uint64_t>* version = nullptr;
 	if(isFoundInModDb)
 	{
-		// Mark entry status as Erased
-		m_modDbStorage.at(index).status.isErased = true;
-		TPT_TRACE(TRACE_INFO, SSTR("Erased entry ", m_modDbStorage.at(index).key, " in Modified DB successfully!"));
-		return index;
+		auto lockStorage = m_stats.lockShared(m_modStorageMutex);
+		version = m_modDbStorage.at(index).version;
 	}
-	else
+	else version = m_dbStorage.at(index).version;
+
+	// Without a stamp the entry may have changed any time
+	return version ? version->load(std::memory_order_acquire) : getVersion();
+}
+
+void DbLoader::findModifiedCopy(std::size_t& index, bool& isFoundInModDb)
+{
+	if(isFoundInModDb) return;
+
+	// Another writer may have copied the entry into the Modified DB since the lookup, which must then be written instead of a second copy
+	auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+	if(const auto it = m_modKeyIndex.indexById.find(m_dbStorage.at(index).id); it != m_modKeyIndex.indexById.end())
 	{
-		// Add new entry with erased status into Modified DB. Do not change anything in Original DB
-		std::scoped_lock<std::mutex> lockStorage(m_storageMutex);
-		std::scoped_lock<std::mutex> lockModDictionary(m_modDictionaryMutex);
-		auto copiedEntry = m_dbStorage.at(index);
-		copiedEntry.status.isErased = true;
-		m_modDbStorage.emplace_back(copiedEntry);
+		index = it->second;
+		isFoundInModDb = true;
+	}
+}
+
+ReturnCodeEnum DbLoader::resetToDefault()
+{
+	const uint64_t startNs = m_stats.startOperation();
+	ReturnCodeEnum rc = resetModifiedDb();
+	m_stats.endOperation(DbStats::Operation::RESET, startNs, rc);
+	return rc;
+}
 
-		std::vector<std::string> subKeys = tokenize(copiedEntry.key, "/");
-		for(const auto& sk : subKeys)
+ReturnCodeEnum DbLoader::resetModifiedDb()
+{
+	// Drops every Modified DB entry, so no other operation may hold an index into it.
+	// Hard writes keep the layout lock shared while they rewrite the file, so none of them still reads an entry copy pointing into m_modDbArena.
+	auto lockLayout = m_stats.lock(m_modLayoutMutex);
+	{
+		auto lockStorage = m_stats.lock(m_modStorageMutex);
+		const uint64_t version = advanceVersion();
+		for(const auto& entry : m_modDbStorage)
+		{
+			stampVersion(entry, version);
+			notifyChange(entry.key, ChangeKind::RESET);
+		}
+		m_modDbStorage.clear();
+		for(std::size_t i = 0; i < m_numberOfScalarSlots; ++i)
 		{
-			m_modDbDictionary[sk].insert(m_modDbStorage.size() - 1); // Storing the index of entry in m_dbStorage vector
+			m_scalarSlots[i].word.store(m_scalarSlots[i].originalValue, std::memory_order_relaxed);
 		}
+		m_erasedEntries.clearAll();
+		auto lockDictionary = m_stats.lock(m_modDictionaryMutex);
+		m_modDbDictionary.clear();
+		m_modKeyIndex.indexById.clear();
+		m_modKeyIndex.hardSavedOnlyIds.clear();
+		// No entry nor dictionary token refers to it anymore, unless a snapshot still holds a copy of them
+		if(m_numberOfSnapshots.load(std::memory_order_acquire) == 0) m_modDbArena.clear();
+	}
+
+	// The file is dropped once readers got the layout lock back, hard writes coming after the reset drop it first, see applyPendingHardSave()
+	{
+		std::scoped_lock<std::mutex> lockPending(m_pendingHardSaveMutex);
+		m_isHardSaveResetPending = true;
+		m_pendingRestoredKeys.clear();
+	}
+	lockLayout.unlock();
+	{
+		std::scoped_lock<std::mutex> lockHardSave(m_hardSaveMutex);
+		applyPendingHardSave();
+	}
+
+	DB_TRACE(TRACE_INFO, "Database settings reset to default successfully!");
+	return ReturnCodeEnum(ReturnCodeRaw::OK);
+}
+
+bool DbLoader::checkIfErased(const std::size_t& index, const bool& isFoundInModDb)
+{
+	// The id of an Original DB entry is its index, only the one of a Modified DB entry has to be read under the lock
+	std::size_t id = index;
+	if(isFoundInModDb)
+	{
+		auto lockStorage = m_stats.lockShared(m_modStorageMutex);
+		id = m_modDbStorage.at(index).id;
+	}
 
-		TPT_TRACE(TRACE_INFO, SSTR("Added erased entry ", copiedEntry.key, " into Modified DB successfully!"));
-		return m_modDbStorage.size() - 1;
+	if(m_erasedEntries.test(id))
+	{
+		DB_TRACE(TRACE_ABN, "DB key with id ", id, " was already erased!");
+		return true;
 	}
+
+	return false;
 }
 
 ReturnCodeEnum DbLoader::erase(const std::string& key)
 {
+	const uint64_t startNs = m_stats.startOperation();
+	ReturnCodeEnum rc = eraseEntry(key);
+	m_stats.endOperation(DbStats::Operation::ERASE, startNs, rc);
+	return rc;
+}
+
+ReturnCodeEnum DbLoader::eraseEntry(const std::string& key)
+{
+	auto lockLayout = m_stats.lockShared(m_modLayoutMutex);
 	const auto& it = findMatchingIndices(key);
 	if(!it.has_value()) return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
 
 	const auto& [index, isFoundInModDb] = it.value();
 
-	if(!checkIfErased(index, isFoundInModDb))
+	// Nothing is copied into the Modified DB, its entry (if any) keeps its values until restore() or reset() drops it.
+	// The lock orders the erase with the writers, which test the bit under it, and with takeSnapshot().
+	auto lockStorage = m_stats.lock(m_modStorageMutex);
+	const DbEntry& entry = isFoundInModDb ? m_modDbStorage.at(index) : m_dbStorage.at(index);
+
+	// The slot first, lock-free writers stop at its state bit before the key reads as erased
+	if(entry.scalar) entry.scalar->word.fetch_or(ScalarSlot::IS_ERASED, std::memory_order_relaxed);
+	if(m_erasedEntries.set(entry.id))
+	{
+		commitChange(entry, ChangeKind::ERASED);
+		DB_TRACE(TRACE_INFO, "Erased entry ", entry.key, " successfully!");
+	}
+	else
 	{
-		(void)eraseDbEntry(index, isFoundInModDb);
+		DB_TRACE(TRACE_ABN, "DB key ", entry.key, " was already erased!");
 	}
 
 	return ReturnCodeEnum(ReturnCodeRaw::OK);
@@ -1009,59 +1894,149 @@ ReturnCodeEnum DbLoader::erase(const std::string& key)
 
 ReturnCodeEnum DbLoader::restore(const std::string& key)
 {
-	auto indices = findMatchingKeys(key, m_modDbDictionary, m_modDictionaryMutex);
-	if(indices.empty())
+	const uint64_t startNs = m_stats.startOperation();
+	ReturnCodeEnum rc = restoreEntries(key);
+	m_stats.endOperation(DbStats::Operation::RESTORE, startNs, rc);
+	return rc;
+}
+
+ReturnCodeEnum DbLoader::restoreEntries(const std::string& key)
+{
+	// Restored entries are erased from the Modified DB and the ones behind them move, no other operation may hold an index meanwhile
+	auto lockLayout = m_stats.lock(m_modLayoutMutex);
+	std::optional<std::pair<std::size_t, bool>> wholeKey;
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("No DB entry with key ", key, " need to restore!"));
-		return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+		auto lockDictionary = m_stats.lockShared(m_modDictionaryMutex);
+		wholeKey = findWholeKey(key, m_modKeyIndex);
 	}
 
-	// Restore all entry found in Modified DB
+	// A whole key only restores its own copy, a partial key every copy it matches
+	std::vector<std::size_t> indices;
+	if(!wholeKey.has_value()) indices = findMatchingKeys(key, m_modDbDictionary, m_modDictionaryMutex);
+	else if(wholeKey->second) indices.assign(1, wholeKey->first);
+
+	// Restore all entry found in Modified DB, highest index first so that erasing one entry does not move the others still to restore
+	std::sort(indices.begin(), indices.end(), std::greater<std::size_t>());
+	std::vector<std::string> restoredKeys;
+	restoredKeys.reserve(indices.size());
 	for(const auto& index : indices)
 	{
-		restoreHardSavedDb(index);
+		auto lockModStorage = m_stats.lock(m_modStorageMutex);
+		auto lockModDictionary = m_stats.lock(m_modDictionaryMutex);
+		forEachToken(m_modDbStorage.at(index).key, '/', [this, index](std::string_view subKey){
+			m_modDbDictionary[subKey].erase(index);
+			return true;
+		});
+
+		m_modKeyIndex.indexById.erase(m_modDbStorage.at(index).id);
+		if(m_modDbStorage.at(index).id >= m_dbStorage.size()) m_modKeyIndex.hardSavedOnlyIds.erase(m_modDbStorage.at(index).key);
+
+		DB_TRACE(TRACE_INFO, "Restored DB key ", m_modDbStorage.at(index).key, " successfully!");
+		restoredKeys.emplace_back(m_modDbStorage.at(index).key);
+		if(ScalarSlot* slot = m_modDbStorage.at(index).scalar) slot->word.store(slot->originalValue, std::memory_order_relaxed);
+		(void)m_erasedEntries.clear(m_modDbStorage.at(index).id);
+		commitChange(m_modDbStorage.at(index), ChangeKind::RESTORED);
+		m_modDbStorage.erase(m_modDbStorage.begin() + index);
+
+		// All entries behind the restored one moved down by one, keep the dictionary pointing at them
+		for(auto& [subKey, postings] : m_modDbDictionary)
+		{
+			std::unordered_set<std::size_t> shifted;
+			shifted.reserve(postings.size());
+			for(const auto& i : postings)
+			{
+				shifted.insert(i > index ? i - 1 : i);
+			}
+			postings.swap(shifted);
+		}
+		for(auto& [id, modIndex] : m_modKeyIndex.indexById)
+		{
+			if(modIndex > index) --modIndex;
+		}
+	}
+
+	// Erased keys which were never written have no Modified DB entry, only their bit is left to clear
+	if(restoreErasedEntries(key) == 0 && indices.empty())
+	{
+		DB_TRACE(TRACE_ABN, "No DB entry with key ", key, " need to restore!");
+		return ReturnCodeEnum(ReturnCodeRaw::KEY_NOT_FOUND);
+	}
 
-		std::scoped_lock<std::mutex> lockModStorage(m_modStorageMutex);
-		std::scoped_lock<std::mutex> lockModDictionary(m_modDictionaryMutex);
-		std::vector<std::string> subKeys = tokenize(m_modDbStorage.at(index).key, "/");
-		for(const auto& sk : subKeys)
+	// The restored keys are queued while no hard write can come in between, then dropped from the file in one rewrite.
+	// Readers get the layout lock back before that, hard writes coming after the restore apply the queue first.
+	if(!restoredKeys.empty())
+	{
 		{
-			m_modDbDictionary[sk].erase(index);
+			std::scoped_lock<std::mutex> lockPending(m_pendingHardSaveMutex);
+			m_pendingRestoredKeys.insert(m_pendingRestoredKeys.end(), std::make_move_iterator(restoredKeys.begin()),
+				std::make_move_iterator(restoredKeys.end()));
 		}
+		lockLayout.unlock();
 
-		TPT_TRACE(TRACE_INFO, SSTR("Restored DB key ", m_modDbStorage.at(index).key, " successfully!"));
-		m_modDbStorage.erase(m_modDbStorage.begin() + index);
+		std::scoped_lock<std::mutex> lockHardSave(m_hardSaveMutex);
+		applyPendingHardSave();
 	}
 
 	return ReturnCodeEnum(ReturnCodeRaw::OK);
 }
 
-void DbLoader::restoreHardSavedDb(const std::size_t& index)
+std::size_t DbLoader::restoreErasedEntries(std::string_view key)
 {
-	if(!isHardSavedDbFileInit)
+	if(m_erasedEntries.count() == 0) return 0;
+
+	// Same matching as findMatchingIndices() on the Original DB, a partial key restores every erased entry it matches
+	std::vector<std::size_t> indices;
+	if(const auto index = m_keyIndex.find(key); index.has_value()) indices.assign(1, index.value());
+	else if(mayBeFound(key)) indices = findMatchingKeys(key, m_dbDictionary, m_dictionaryMutex);
+
+	std::size_t numberOfRestored = 0;
+	auto lockModStorage = m_stats.lock(m_modStorageMutex);
+	for(const auto& index : indices)
 	{
-		isHardSavedDbFileInit = true;
-		initHardSavedDbFile();
+		const DbEntry& entry = m_dbStorage[index];
+		if(!m_erasedEntries.clear(entry.id)) continue;
+
+		if(entry.scalar) entry.scalar->word.store(entry.scalar->originalValue, std::memory_order_relaxed);
+		commitChange(entry, ChangeKind::RESTORED);
+		++numberOfRestored;
+		DB_TRACE(TRACE_INFO, "Restored erased DB key ", entry.key, " successfully!");
 	}
 
-	std::mutex& mtx = m_modStorageMutex;
-	DatabaseStorage& dbStorage = m_modDbStorage;
+	return numberOfRestored;
+}
 
-	std::scoped_lock<std::mutex> lockStorage(mtx);
-	const auto& updatedEntry = dbStorage.at(index);
+void DbLoader::applyPendingHardSave()
+{
+	bool isResetPending = false;
+	std::vector<std::string> restoredKeys;
+	{
+		std::scoped_lock<std::mutex> lockPending(m_pendingHardSaveMutex);
+		std::swap(isResetPending, m_isHardSaveResetPending);
+		restoredKeys.swap(m_pendingRestoredKeys);
+	}
 
-	std::ifstream inputFile(m_binDbPath + "/swdb-hardsave.bin", std::ifstream::binary);
-	if(!inputFile.is_open())
+	if(isResetPending)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.bin"));
-		return;
+		std::remove(std::string(m_binDbPath + "/swdb-hardsave.bin").c_str());
+		initHardSavedDbFile();
+		isHardSavedDbFileInit = true;
 	}
 
-	std::ofstream outputFile(m_binDbPath + "/swdb-hardsave.tmp.bin", std::ios_base::binary);
-	if(!outputFile.is_open())
+	if(!restoredKeys.empty()) restoreHardSavedDb(std::unordered_set<std::string>(restoredKeys.begin(), restoredKeys.end()));
+}
+
+void DbLoader::restoreHardSavedDb(const std::unordered_set<std::string>& restoredKeys)
+{
+	if(!isHardSavedDbFileInit)
 	{
-		TPT_TRACE(TRACE_ABN, SSTR("Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.tmp.bin"));
-		inputFile.close();
+		isHardSavedDbFileInit = true;
+		initHardSavedDbFile();
+	}
+
+	std::ifstream inputFile(m_binDbPath + "/swdb-hardsave.bin", std::ifstream::binary);
+	if(!inputFile.is_open())
+	{
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.bin");
 		return;
 	}
 
@@ -1077,75 +2052,71 @@ void DbLoader::restoreHardSavedDb(const std::size_t& index)
 	}
 	uint32_t totalEntries = be32toh(*(uint32_t *)buff);
 
-	// Analyze DB entries
+	// Copy every entry but the restored ones
 	char c;
-	bool found = false;
+	uint32_t numberOfRemoved = 0;
 	for(auto i = 0u; i < totalEntries; ++i)
 	{
 		c = inputFile.get();
-		newContent.emplace_back(c);
-		if(c == 'F')
+		if(c != 'F')
 		{
-			std::string key;
-			// Read the "key" in null-terminated string format
-			while((c = inputFile.get()) != '\0')
-			{
-				key += c;
-			}
-
-			if(key == updatedEntry.key)
-			{
-				newContent.pop_back(); // Pop back 'F'
-				// Found the entry which should be updated
-				// By pass "value" in inputFile, write our own one
-				while((c = inputFile.get()) != '\0') {}
+			newContent.emplace_back(c);
+			continue;
+		}
 
-				found = true;
-				break;
-			}
-			else
-			{
-				for(const auto ch : key)
-				{
-					newContent.emplace_back(ch);
-				}
-				newContent.emplace_back('\0');
+		// Read the "key" in null-terminated string format
+		std::string key;
+		while((c = inputFile.get()) != '\0')
+		{
+			key += c;
+		}
 
-				// Copy the next 2 bytes for permission and type
-				for(int j = 0; j < 2; ++j)
-				{
-					newContent.emplace_back(inputFile.get());
-				}
+		// 1 byte of permission and 1 byte of type, then the "value" in null-terminated string format
+		const char permission = inputFile.get();
+		const char type = inputFile.get();
+		std::string value;
+		while((c = inputFile.get()) != '\0')
+		{
+			value += c;
+		}
 
-				// Copy "value" in inputFile into outputFile
-				while((c = inputFile.get()) != '\0')
-				{
-					newContent.emplace_back(c);
-				}
-				
-			}
-			newContent.emplace_back('\0');
+		if(restoredKeys.count(key))
+		{
+			++numberOfRemoved;
+			continue;
 		}
+
+		newContent.emplace_back('F');
+		newContent.insert(newContent.end(), key.begin(), key.end());
+		newContent.emplace_back('\0');
+		newContent.emplace_back(permission);
+		newContent.emplace_back(type);
+		newContent.insert(newContent.end(), value.begin(), value.end());
+		newContent.emplace_back('\0');
 	}
 
-	if(found)
+	// Keys which were only soft written are not in the file, which is then left as it is
+	if(numberOfRemoved == 0) return;
+
+	totalEntries = htobe32(totalEntries - numberOfRemoved);
+	for(int j = 0; j < 4; ++j)
 	{
-		// Decrease total number of entries by one
-		totalEntries = htobe32(--totalEntries);
-		for(int j = 0; j < 4; ++j)
-		{
-			newContent.at(j) = *((char *)(&totalEntries) + j);
-		}
+		newContent.at(j) = *((char *)(&totalEntries) + j);
 	}
 
 	while((c = inputFile.get()) != EOF)
 	{
 		newContent.emplace_back(c);
 	}
+	inputFile.close();
 
+	std::ofstream outputFile(m_binDbPath + "/swdb-hardsave.tmp.bin", std::ios_base::binary);
+	if(!outputFile.is_open())
+	{
+		DB_TRACE(TRACE_ABN, "Could not open DB binary file ", m_binDbPath, "/swdb-hardsave.tmp.bin");
+		return;
+	}
 	outputFile.write(newContent.data(), newContent.size());
-
-	inputFile.close();
 	outputFile.close();
 
 	std::remove(std::string(m_binDbPath + "/swdb-hardsave.bin").c_str());
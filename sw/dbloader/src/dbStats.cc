@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "dbStats.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+DbStats::DbStats() : m_shards(std::make_unique<Shard[]>(NUMBER_OF_SHARDS))
+{
+	// Allow turning stats on for a whole process without touching its code
+	if(const char* env = std::getenv("DBENGINE_STATS"); env != nullptr && std::strcmp(env, "1") == 0)
+	{
+		setEnabled(true);
+	}
+}
+
+DatabaseStats DbStats::getSnapshot() const
+{
+	DatabaseStats snapshot;
+	snapshot.isEnabled = isEnabled();
+
+	LatencyHistogram* operations[] = {&snapshot.get, &snapshot.softUpdate, &snapshot.hardUpdate, &snapshot.erase, &snapshot.restore, &snapshot.reset,
+		&snapshot.getMany};
+	static_assert(sizeof(operations) / sizeof(operations[0]) == static_cast<std::size_t>(Operation::NUMBER_OF_OPERATIONS));
+
+	for(std::size_t s = 0; s < NUMBER_OF_SHARDS; ++s)
+	{
+		const Shard& shard = m_shards[s];
+		for(std::size_t op = 0; op < shard.latencies.size(); ++op)
+		{
+			collect(shard.latencies[op], *operations[op]);
+		}
+		collect(shard.lockWait, snapshot.lockWait);
+
+		const auto counter = [&shard](Counter c){
+			return shard.counters[static_cast<std::size_t>(c)].load(std::memory_order_relaxed);
+		};
+		snapshot.modifiedDbHits += counter(Counter::MODIFIED_DB_HITS);
+		snapshot.originalDbHits += counter(Counter::ORIGINAL_DB_HITS);
+		snapshot.keyNotFound += counter(Counter::KEY_NOT_FOUND);
+		snapshot.typeMismatch += counter(Counter::TYPE_MISMATCH);
+		snapshot.notWritable += counter(Counter::NOT_WRITABLE);
+		snapshot.uncontendedLocks += counter(Counter::UNCONTENDED_LOCKS);
+		snapshot.filterRejects += counter(Counter::FILTER_REJECTS);
+		snapshot.filterFalsePositives += counter(Counter::FILTER_FALSE_POSITIVES);
+		snapshot.readCacheHits += counter(Counter::READ_CACHE_HITS);
+	}
+
+	return snapshot;
+}
+
+void DbStats::collect(const AtomicHistogram& histogram, LatencyHistogram& result)
+{
+	for(std::size_t i = 0; i < LatencyHistogram::NUMBER_OF_BUCKETS; ++i)
+	{
+		result.buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+	}
+	result.count += histogram.count.load(std::memory_order_relaxed);
+	result.totalNs += histogram.totalNs.load(std::memory_order_relaxed);
+	result.maxNs = std::max(result.maxNs, histogram.maxNs.load(std::memory_order_relaxed));
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,40 @@
+#include "erasedBitmap.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+void ErasedBitmap::reset(std::size_t numberOfIds)
+{
+	m_numberOfIds = numberOfIds;
+	m_words = std::make_unique<std::atomic<uint64_t>[]>((numberOfIds + 63) / 64); // Zero-initialized
+	m_count.store(0, std::memory_order_relaxed);
+}
+
+void ErasedBitmap::clearAll()
+{
+	for(std::size_t i = 0; i < (m_numberOfIds + 63) / 64; ++i)
+	{
+		m_words[i].store(0, std::memory_order_relaxed);
+	}
+	m_count.store(0, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> ErasedBitmap::copyWords() const
+{
+	std::vector<uint64_t> words((m_numberOfIds + 63) / 64);
+	for(std::size_t i = 0; i < words.size(); ++i)
+	{
+		words[i] = m_words[i].load(std::memory_order_relaxed);
+	}
+	return words;
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,94 @@
+#include <algorithm>
+
+#include "hotKeyTracker.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+void HotKeyTracker::enable(uint32_t samplingPeriod, std::size_t capacity)
+{
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	for(auto& sketch : m_sketches)
+	{
+		sketch.reset(samplingPeriod ? std::max<std::size_t>(1, capacity) : 0);
+	}
+	m_samplingPeriod.store(samplingPeriod, std::memory_order_relaxed);
+}
+
+void HotKeyTracker::record(Access access, std::string_view key)
+{
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	m_sketches[static_cast<std::size_t>(access)].add(key);
+}
+
+HotKeyReport HotKeyTracker::getReport(std::size_t topK) const
+{
+	HotKeyReport report;
+
+	std::scoped_lock<std::mutex> lock(m_mutex);
+	report.samplingPeriod = m_samplingPeriod.load(std::memory_order_relaxed);
+	report.reads = m_sketches[static_cast<std::size_t>(Access::READ)].getTop(topK, report.samplingPeriod);
+	report.writes = m_sketches[static_cast<std::size_t>(Access::WRITE)].getTop(topK, report.samplingPeriod);
+	report.misses = m_sketches[static_cast<std::size_t>(Access::MISS)].getTop(topK, report.samplingPeriod);
+	return report;
+}
+
+void HotKeyTracker::SpaceSaving::reset(std::size_t capacity)
+{
+	m_capacity = capacity;
+	m_counters.clear();
+	m_counters.reserve(capacity);
+}
+
+void HotKeyTracker::SpaceSaving::add(std::string_view key)
+{
+	if(m_capacity == 0) return;
+
+	std::string keyStr(key);
+	if(auto it = m_counters.find(keyStr); it != m_counters.end())
+	{
+		++it->second.count;
+		return;
+	}
+
+	if(m_counters.size() < m_capacity)
+	{
+		m_counters.emplace(std::move(keyStr), Counter {1, 0});
+		return;
+	}
+
+	// Space-Saving: the new key takes over the counter with the smallest count, inheriting it as its error
+	auto minIt = std::min_element(m_counters.begin(), m_counters.end(), [](const auto& lhs, const auto& rhs){
+		return lhs.second.count < rhs.second.count;
+	});
+	const uint64_t minCount = minIt->second.count;
+	m_counters.erase(minIt);
+	m_counters.emplace(std::move(keyStr), Counter {minCount + 1, minCount});
+}
+
+std::vector<HotKey> HotKeyTracker::SpaceSaving::getTop(std::size_t topK, uint32_t scale) const
+{
+	std::vector<HotKey> hotKeys;
+	hotKeys.reserve(m_counters.size());
+	for(const auto& [key, counter] : m_counters)
+	{
+		hotKeys.push_back(HotKey {key, counter.count * scale, counter.error * scale});
+	}
+
+	const std::size_t count = std::min(topK, hotKeys.size());
+	std::partial_sort(hotKeys.begin(), hotKeys.begin() + count, hotKeys.end(), [](const HotKey& lhs, const HotKey& rhs){
+		return lhs.count != rhs.count ? lhs.count > rhs.count : lhs.key < rhs.key;
+	});
+	hotKeys.resize(count);
+	return hotKeys;
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
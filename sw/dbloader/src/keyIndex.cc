@@ -0,0 +1,358 @@
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "keyIndex.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+KeyIndex::~KeyIndex()
+{
+	clear();
+}
+
+void KeyIndex::clear()
+{
+	freeTree(m_root);
+	m_root = nullptr;
+	m_size = 0;
+	m_numberOfBytes = 0;
+}
+
+void KeyIndex::insert(std::string_view key, uint32_t value)
+{
+	Node** ref = &m_root;
+	std::size_t depth = 0;
+	while(*ref != nullptr)
+	{
+		Node* node = *ref;
+		const std::size_t matched = matchPrefix(*node, key, depth);
+		if(matched < node->prefixLength)
+		{
+			// The key leaves the compressed path, split it in front of the first different byte
+			Node4* parent = allocate<Node4>(NodeType::NODE4);
+			parent->prefix = node->prefix;
+			parent->prefixLength = matched;
+
+			const uint8_t byte = static_cast<uint8_t>(node->prefix[matched]);
+			node->prefix += matched + 1;
+			node->prefixLength -= matched + 1;
+			*ref = parent;
+			addChild(ref, byte, node);
+
+			depth += matched;
+			if(depth == key.size()) parent->value = value;
+			else addChild(ref, static_cast<uint8_t>(key[depth]), makeLeaf(key, depth + 1, value));
+
+			++m_size;
+			return;
+		}
+
+		depth += node->prefixLength;
+		if(depth == key.size())
+		{
+			if(node->value == NO_VALUE)
+			{
+				node->value = value;
+				++m_size;
+			}
+			return;
+		}
+
+		Node* const* child = findChild(node, static_cast<uint8_t>(key[depth]));
+		if(child == nullptr)
+		{
+			addChild(ref, static_cast<uint8_t>(key[depth]), makeLeaf(key, depth + 1, value));
+			++m_size;
+			return;
+		}
+
+		ref = const_cast<Node**>(child);
+		++depth;
+	}
+
+	*ref = makeLeaf(key, depth, value);
+	++m_size;
+}
+
+std::optional<uint32_t> KeyIndex::find(std::string_view key) const
+{
+	const Node* node = m_root;
+	std::size_t depth = 0;
+	while(node != nullptr)
+	{
+		if(node->prefixLength > key.size() - depth || std::memcmp(node->prefix, key.data() + depth, node->prefixLength) != 0) return std::nullopt;
+		depth += node->prefixLength;
+
+		if(depth == key.size())
+		{
+			if(node->value == NO_VALUE) return std::nullopt;
+			return node->value;
+		}
+
+		Node* const* child = findChild(node, static_cast<uint8_t>(key[depth++]));
+		node = child ? *child : nullptr;
+	}
+
+	return std::nullopt;
+}
+
+std::optional<std::pair<std::size_t, uint32_t>> KeyIndex::findLongestPrefix(std::string_view key, char delimiter) const
+{
+	std::optional<std::pair<std::size_t, uint32_t>> longest;
+	const Node* node = m_root;
+	std::size_t depth = 0;
+	while(node != nullptr)
+	{
+		if(matchPrefix(*node, key, depth) < node->prefixLength) break;
+		depth += node->prefixLength;
+
+		if(node->value != NO_VALUE && (depth == key.size() || key[depth] == delimiter)) longest = std::make_pair(depth, node->value);
+		if(depth == key.size()) break;
+
+		Node* const* child = findChild(node, static_cast<uint8_t>(key[depth++]));
+		node = child ? *child : nullptr;
+	}
+
+	return longest;
+}
+
+KeyIndex::Node* const* KeyIndex::findChild(const Node* node, uint8_t byte)
+{
+	switch(node->type)
+	{
+	case NodeType::NODE4:
+	{
+		const Node4* n = static_cast<const Node4*>(node);
+		for(uint16_t i = 0; i < n->numberOfChildren; ++i)
+		{
+			if(n->keys[i] == byte) return &n->children[i];
+		}
+		return nullptr;
+	}
+
+	case NodeType::NODE16:
+	{
+		const Node16* n = static_cast<const Node16*>(node);
+#if defined(__SSE2__)
+		// Compare all 16 keys at once, bits of unused slots are masked out
+		const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+		const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << n->numberOfChildren) - 1);
+		return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+		for(uint16_t i = 0; i < n->numberOfChildren; ++i)
+		{
+			if(n->keys[i] == byte) return &n->children[i];
+		}
+		return nullptr;
+#endif
+	}
+
+	case NodeType::NODE48:
+	{
+		const Node48* n = static_cast<const Node48*>(node);
+		return n->childIndex[byte] ? &n->children[n->childIndex[byte] - 1] : nullptr;
+	}
+
+	case NodeType::NODE256:
+	{
+		const Node256* n = static_cast<const Node256*>(node);
+		return n->children[byte] ? &n->children[byte] : nullptr;
+	}
+
+	default:
+		return nullptr;
+	}
+}
+
+KeyIndex::Node* KeyIndex::makeLeaf(std::string_view key, std::size_t depth, uint32_t value)
+{
+	Node* leaf = allocate<Node>(NodeType::LEAF);
+	leaf->prefix = key.data() + depth;
+	leaf->prefixLength = key.size() - depth;
+	leaf->value = value;
+	return leaf;
+}
+
+void KeyIndex::addChild(Node** ref, uint8_t byte, Node* child)
+{
+	Node* node = *ref;
+	const bool isFull = (node->type == NodeType::LEAF) || (node->type == NodeType::NODE4 && node->numberOfChildren == 4) ||
+		(node->type == NodeType::NODE16 && node->numberOfChildren == 16) || (node->type == NodeType::NODE48 && node->numberOfChildren == 48);
+	if(isFull)
+	{
+		node = grow(node);
+		*ref = node;
+	}
+
+	// Node4 and Node16 keep their keys sorted, so that visiting their children in slot order gives the keys in order
+	const auto insertSorted = [byte, child](auto* n){
+		uint16_t i = n->numberOfChildren;
+		while(i > 0 && n->keys[i - 1] > byte)
+		{
+			n->keys[i] = n->keys[i - 1];
+			n->children[i] = n->children[i - 1];
+			--i;
+		}
+		n->keys[i] = byte;
+		n->children[i] = child;
+	};
+
+	switch(node->type)
+	{
+	case NodeType::NODE4:
+		insertSorted(static_cast<Node4*>(node));
+		break;
+
+	case NodeType::NODE16:
+		insertSorted(static_cast<Node16*>(node));
+		break;
+
+	case NodeType::NODE48:
+		static_cast<Node48*>(node)->children[node->numberOfChildren] = child;
+		static_cast<Node48*>(node)->childIndex[byte] = node->numberOfChildren + 1;
+		break;
+
+	case NodeType::NODE256:
+		static_cast<Node256*>(node)->children[byte] = child;
+		break;
+
+	default:
+		break;
+	}
+
+	++node->numberOfChildren;
+}
+
+KeyIndex::Node* KeyIndex::grow(Node* node)
+{
+	const auto copyHeader = [node](Node* grown){
+		grown->numberOfChildren = node->numberOfChildren;
+		grown->value = node->value;
+		grown->prefixLength = node->prefixLength;
+		grown->prefix = node->prefix;
+	};
+
+	Node* grown = nullptr;
+	switch(node->type)
+	{
+	case NodeType::LEAF:
+		grown = allocate<Node4>(NodeType::NODE4);
+		copyHeader(grown);
+		break;
+
+	case NodeType::NODE4:
+	{
+		Node16* n = allocate<Node16>(NodeType::NODE16);
+		copyHeader(n);
+		std::memcpy(n->keys, static_cast<Node4*>(node)->keys, sizeof(Node4::keys));
+		std::memcpy(n->children, static_cast<Node4*>(node)->children, sizeof(Node4::children));
+		grown = n;
+		break;
+	}
+
+	case NodeType::NODE16:
+	{
+		Node48* n = allocate<Node48>(NodeType::NODE48);
+		copyHeader(n);
+		for(uint16_t i = 0; i < node->numberOfChildren; ++i)
+		{
+			n->childIndex[static_cast<Node16*>(node)->keys[i]] = i + 1;
+			n->children[i] = static_cast<Node16*>(node)->children[i];
+		}
+		grown = n;
+		break;
+	}
+
+	case NodeType::NODE48:
+	{
+		Node256* n = allocate<Node256>(NodeType::NODE256);
+		copyHeader(n);
+		for(std::size_t byte = 0; byte < 256; ++byte)
+		{
+			const uint8_t slot = static_cast<Node48*>(node)->childIndex[byte];
+			if(slot) n->children[byte] = static_cast<Node48*>(node)->children[slot - 1];
+		}
+		grown = n;
+		break;
+	}
+
+	default:
+		return node;
+	}
+
+	freeNode(node);
+	return grown;
+}
+
+void KeyIndex::freeNode(Node* node)
+{
+	switch(node->type)
+	{
+	case NodeType::NODE4:
+		m_numberOfBytes -= sizeof(Node4);
+		delete static_cast<Node4*>(node);
+		break;
+
+	case NodeType::NODE16:
+		m_numberOfBytes -= sizeof(Node16);
+		delete static_cast<Node16*>(node);
+		break;
+
+	case NodeType::NODE48:
+		m_numberOfBytes -= sizeof(Node48);
+		delete static_cast<Node48*>(node);
+		break;
+
+	case NodeType::NODE256:
+		m_numberOfBytes -= sizeof(Node256);
+		delete static_cast<Node256*>(node);
+		break;
+
+	default:
+		m_numberOfBytes -= sizeof(Node);
+		delete node;
+		break;
+	}
+}
+
+void KeyIndex::freeTree(Node* node)
+{
+	if(node == nullptr) return;
+
+	switch(node->type)
+	{
+	case NodeType::NODE4:
+		for(uint16_t i = 0; i < node->numberOfChildren; ++i) freeTree(static_cast<Node4*>(node)->children[i]);
+		break;
+
+	case NodeType::NODE16:
+		for(uint16_t i = 0; i < node->numberOfChildren; ++i) freeTree(static_cast<Node16*>(node)->children[i]);
+		break;
+
+	case NodeType::NODE48:
+		for(uint16_t i = 0; i < node->numberOfChildren; ++i) freeTree(static_cast<Node48*>(node)->children[i]);
+		break;
+
+	case NodeType::NODE256:
+		for(Node* child : static_cast<Node256*>(node)->children) freeTree(child);
+		break;
+
+	default:
+		break;
+	}
+
+	freeNode(node);
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
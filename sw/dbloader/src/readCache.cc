@@ -0,0 +1,41 @@
+#include "readCache.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+void ReadCache::enable(std::size_t capacity)
+{
+	std::size_t roundedCapacity = capacity ? 1 : 0;
+	while(roundedCapacity < capacity) roundedCapacity <<= 1;
+
+	m_capacity.store(roundedCapacity, std::memory_order_relaxed);
+	m_configuration.fetch_add(1, std::memory_order_release);
+}
+
+ReadCache::Slot* ReadCache::getSlot(std::size_t hash)
+{
+	// One cache per thread, freed when the thread exits
+	thread_local LocalCache localCache;
+
+	const uint64_t configuration = m_configuration.load(std::memory_order_acquire);
+	if(localCache.configuration != configuration)
+	{
+		localCache.configuration = configuration;
+		localCache.slots.clear();
+		localCache.slots.shrink_to_fit();
+		localCache.slots.resize(m_capacity.load(std::memory_order_relaxed));
+	}
+
+	if(localCache.slots.empty()) return nullptr;
+	return &localCache.slots[hash & (localCache.slots.size() - 1)];
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
@@ -0,0 +1,79 @@
+#include <cstring>
+#include <algorithm>
+
+#include "stringArena.h"
+
+namespace DbEngine
+{
+namespace DatabaseIf
+{
+namespace V1
+{
+
+StringArena::StringArena(std::size_t blockSize) : m_blockSize(blockSize)
+{
+}
+
+std::string_view StringArena::intern(std::string_view str)
+{
+	if(const auto& it = m_internedStrings.find(str); it != m_internedStrings.end())
+	{
+		return *it;
+	}
+
+	auto interned = allocate(str);
+	m_internedStrings.insert(interned);
+	return interned;
+}
+
+void StringArena::clear()
+{
+	m_internedStrings.clear();
+	m_blocks.clear();
+	m_bytesUsed = 0;
+	m_bytesReserved = 0;
+}
+
+std::size_t StringArena::getNumberOfStrings() const
+{
+	return m_internedStrings.size();
+}
+
+std::size_t StringArena::getNumberOfBytesUsed() const
+{
+	return m_bytesUsed;
+}
+
+std::size_t StringArena::getNumberOfBytesReserved() const
+{
+	return m_bytesReserved;
+}
+
+std::string_view StringArena::allocate(std::string_view str)
+{
+	if(str.empty()) return std::string_view();
+
+	if(m_blocks.empty() || m_blocks.back().capacity - m_blocks.back().used < str.length())
+	{
+		// Oversized strings get a dedicated block, so that one long CHAR value does not waste the rest of a normal block
+		Block newBlock;
+		newBlock.capacity = std::max(m_blockSize, str.length());
+		newBlock.data = std::make_unique<char[]>(newBlock.capacity);
+		m_bytesReserved += newBlock.capacity;
+		m_blocks.emplace_back(std::move(newBlock));
+	}
+
+	Block& block = m_blocks.back();
+	char* dst = block.data.get() + block.used;
+	std::memcpy(dst, str.data(), str.length());
+	block.used += str.length();
+	m_bytesUsed += str.length();
+
+	return std::string_view(dst, str.length());
+}
+
+} // namespace V1
+
+} // namespace DatabaseIf
+
+} // namespace DbEngine
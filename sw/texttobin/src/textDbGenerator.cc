@@ -0,0 +1,342 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <random>
+#include <cstdint>
+#include <unistd.h>
+
+// Only raw std::mt19937_64 output is used (no std::*_distribution), its sequence is fixed by the standard,
+// so the same seed produces the same text database with every compiler and standard library.
+// Never call rng() twice within one expression, the evaluation order of operands is unspecified.
+using Rng = std::mt19937_64;
+
+struct GeneratorConfig
+{
+	std::string txtFilePath {""};
+	uint32_t numberOfEntries {1000};
+	uint32_t maxKeyDepth {6};
+	uint32_t tokenReuse {16};
+	uint32_t maxArrayLength {4};
+	std::vector<std::pair<std::string, uint32_t>> typeMix {{"U8", 1}, {"S8", 1}, {"U16", 1}, {"S16", 1}, {"U32", 1}, {"S32", 1}, {"U64", 1}, {"S64", 1}, {"CHAR", 1}};
+	uint32_t commentPercent {10};
+	uint32_t hexPercent {10};
+	uint32_t wildcardPercent {5};
+	uint64_t seed {1};
+	bool isTagged {false};
+};
+
+struct GeneratorStats
+{
+	uint64_t entries {0};
+	uint64_t comments {0};
+	uint64_t wildcardKeys {0};
+	uint64_t hexValues {0};
+	uint64_t values {0};
+	uint64_t maxKeyLength {0};
+};
+
+static const std::vector<std::string> SUBKEY_WORDS = {"sensor", "module", "driver", "port", "channel", "board", "radio", "fan", "psu", "clock", "antenna", "carrier"};
+static const std::vector<std::string> LEAF_WORDS = {"temperature", "voltage", "current", "power", "frequency", "threshold", "timeout", "retry", "gain", "delay"};
+static const std::vector<std::string> LEAF_SUFFIXES = {"Ranges", "Levels", "Limit", "Enabled", "Mask", "Period", "Name", "Offsets"};
+static const std::vector<std::string> CHAR_WORDS = {"SPI", "I2C", "UART", "GPIO", "tempSensorDcDc:v1.0.1", "L", "P", "F", "auto", "manual", "eth0", "eth1"};
+
+void printUsage(const char* program);
+bool parseTypeMix(const std::string& mix, std::vector<std::pair<std::string, uint32_t>>& typeMix);
+const std::string& pickType(const GeneratorConfig& cfg, Rng& rng);
+std::string generateKey(const GeneratorConfig& cfg, uint32_t index, Rng& rng, GeneratorStats& stats);
+std::string generateValue(const GeneratorConfig& cfg, const std::string& type, Rng& rng, GeneratorStats& stats);
+std::string generateTaggedValue(const GeneratorConfig& cfg, const std::string& type, uint32_t index, Rng& rng, GeneratorStats& stats);
+std::string generateComment(uint32_t index, Rng& rng);
+
+
+/* Format: ./textDbGenerator -o <path_to_txt_DB_file> [options]						*/
+/* Options:												*/
+/* 	+ o: path to the generated text-based database file						*/
+/* 	+ n: number of entries (default 1000)								*/
+/* 	+ d: maximum number of sub-keys per key, at least 3 (default 6)					*/
+/* 	+ r: token reuse, number of distinct sub-keys per key level (default 16)			*/
+/* 	+ a: maximum number of values per entry (default 4)						*/
+/* 	+ m: weighted type mix, e.g. U8:3,U32,CHAR:2 (default all types, equal weights)			*/
+/* 	+ c: percentage of entries preceded by a comment block (default 10)				*/
+/* 	+ x: percentage of unsigned numeric values written as hex literals (default 10)			*/
+/* 	+ w: percentage of wildcard keys, e.g. /hw/prod_1.14.x/... (default 5)				*/
+/* 	+ s: seed, the same seed and options always generate the same file (default 1)			*/
+/* 	+ t: tagged values, the first value of an entry tags its index and all others hold one		*/
+/* 	     generation, every entry has exactly -a values, at least 2, and -x is ignored			*/
+int main(int argc, char* argv[])
+{
+	GeneratorConfig cfg;
+	int opt = 0;
+
+	while((opt = getopt(argc, argv, "o:n:d:r:a:m:c:x:w:s:t")) != -1)
+	{
+		switch (opt)
+		{
+		case 'o':
+			cfg.txtFilePath = std::string(optarg);
+			break;
+		case 'n':
+			cfg.numberOfEntries = std::stoul(optarg);
+			break;
+		case 'd':
+			cfg.maxKeyDepth = std::max(3ul, std::stoul(optarg));
+			break;
+		case 'r':
+			cfg.tokenReuse = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'a':
+			cfg.maxArrayLength = std::max(1ul, std::stoul(optarg));
+			break;
+		case 'm':
+			if(!parseTypeMix(optarg, cfg.typeMix))
+			{
+				std::cout << "ERROR: Invalid type mix: " << optarg << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 'c':
+			cfg.commentPercent = std::min(100ul, std::stoul(optarg));
+			break;
+		case 'x':
+			cfg.hexPercent = std::min(100ul, std::stoul(optarg));
+			break;
+		case 'w':
+			cfg.wildcardPercent = std::min(100ul, std::stoul(optarg));
+			break;
+		case 's':
+			cfg.seed = std::stoull(optarg);
+			break;
+		case 't':
+			cfg.isTagged = true;
+			break;
+		default:
+			printUsage(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if(cfg.isTagged)
+	{
+		cfg.maxArrayLength = std::max(2u, cfg.maxArrayLength);
+	}
+
+	if(cfg.txtFilePath.empty())
+	{
+		std::cout << "ERROR: Empty file path given, double check execute command!" << std::endl;
+		printUsage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	std::ofstream txtFile(cfg.txtFilePath);
+	if(!txtFile.is_open())
+	{
+		// ERROR TRACE
+		std::cout << "ERROR: Failed to open file: " << cfg.txtFilePath << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	Rng rng(cfg.seed);
+	GeneratorStats stats;
+
+	txtFile << "/* Generated by textDbGenerator: " << cfg.numberOfEntries << " entries, seed " << cfg.seed << " */\n";
+	for(uint32_t i = 0; i < cfg.numberOfEntries; ++i)
+	{
+		if(rng() % 100 < cfg.commentPercent)
+		{
+			txtFile << "\n" << generateComment(i, rng);
+			++stats.comments;
+		}
+
+		const std::string& type = pickType(cfg, rng);
+		const std::string key = generateKey(cfg, i, rng, stats);
+		const char* permission = (rng() % 4) ? "RW" : "R";
+		const std::string value = cfg.isTagged ? generateTaggedValue(cfg, type, i, rng, stats) : generateValue(cfg, type, rng, stats);
+		txtFile << key << "\t\t" << permission << "\t" << type << "\t" << value << "\n";
+		++stats.entries;
+	}
+
+	txtFile.close();
+
+	std::cout << "INFO: " << stats.entries << " entries, " << stats.values << " values (" << stats.hexValues << " hex), "
+		<< stats.wildcardKeys << " wildcard keys, " << stats.comments << " comment blocks, longest key "
+		<< stats.maxKeyLength << " bytes" << std::endl;
+
+	exit(EXIT_SUCCESS);
+}
+
+void printUsage(const char* program)
+{
+	std::cout << "ERROR:\n";
+	std::cout << "\tUsage:  " << program << " -o <path_to_txt_DB_file> [-n entries] [-d depth] [-r reuse] [-a array length] [-m type mix] [-c comment %] [-x hex %] [-w wildcard %] [-s seed] [-t]\n";
+	std::cout << "\tOption:\n";
+	std::cout << "\t\t -o : path to the generated text-based database file.\n";
+	std::cout << "\t\t -n : number of entries.\n";
+	std::cout << "\t\t -d : maximum number of sub-keys per key, at least 3.\n";
+	std::cout << "\t\t -r : number of distinct sub-keys per key level, lower means more token reuse.\n";
+	std::cout << "\t\t -a : maximum number of values per entry.\n";
+	std::cout << "\t\t -m : weighted type mix, e.g. U8:3,U32,CHAR:2.\n";
+	std::cout << "\t\t -c : percentage of entries preceded by a comment block.\n";
+	std::cout << "\t\t -x : percentage of unsigned numeric values written as hex literals.\n";
+	std::cout << "\t\t -w : percentage of wildcard keys.\n";
+	std::cout << "\t\t -s : seed of the generated database.\n";
+	std::cout << "\t\t -t : tagged values, the first one tags the entry index, all others hold one generation.\n";
+}
+
+bool parseTypeMix(const std::string& mix, std::vector<std::pair<std::string, uint32_t>>& typeMix)
+{
+	static const std::unordered_set<std::string> knownTypes = {"U8", "S8", "U16", "S16", "U32", "S32", "U64", "S64", "CHAR"};
+
+	typeMix.clear();
+	std::stringstream ss(mix);
+	std::string item;
+	while(std::getline(ss, item, ','))
+	{
+		if(item.empty()) continue;
+
+		std::string type = item;
+		uint32_t weight = 1;
+		if(auto pos = item.find(':'); pos != std::string::npos)
+		{
+			type = item.substr(0, pos);
+			try
+			{
+				weight = std::stoul(item.substr(pos + 1));
+			}
+			catch(...)
+			{
+				return false;
+			}
+		}
+
+		if(knownTypes.find(type) == knownTypes.end()) return false;
+		if(weight > 0) typeMix.emplace_back(type, weight);
+	}
+
+	return !typeMix.empty();
+}
+
+const std::string& pickType(const GeneratorConfig& cfg, Rng& rng)
+{
+	uint64_t totalWeight = 0;
+	for(const auto& t : cfg.typeMix) totalWeight += t.second;
+
+	uint64_t pick = rng() % totalWeight;
+	for(const auto& t : cfg.typeMix)
+	{
+		if(pick < t.second) return t.first;
+		pick -= t.second;
+	}
+
+	return cfg.typeMix.back().first;
+}
+
+std::string generateKey(const GeneratorConfig& cfg, uint32_t index, Rng& rng, GeneratorStats& stats)
+{
+	// /<hw|sw>/prod_1.14.<n>/<sub-keys reused across entries>.../<leaf><index>, the index keeps every key unique
+	std::string key = (rng() % 2) ? "/hw" : "/sw";
+
+	if(rng() % 100 < cfg.wildcardPercent)
+	{
+		key += "/prod_1.14.x";
+		++stats.wildcardKeys;
+	}
+	else
+	{
+		key += "/prod_1.14." + std::to_string(rng() % 16);
+	}
+
+	const uint32_t depth = 3 + rng() % (cfg.maxKeyDepth - 2);
+	for(uint32_t d = 3; d < depth; ++d)
+	{
+		const uint64_t token = rng() % cfg.tokenReuse;
+		key += "/" + SUBKEY_WORDS[token % SUBKEY_WORDS.size()] + std::to_string(token);
+	}
+
+	const std::string& leafWord = LEAF_WORDS[rng() % LEAF_WORDS.size()];
+	key += "/" + leafWord + LEAF_SUFFIXES[rng() % LEAF_SUFFIXES.size()] + std::to_string(index);
+
+	stats.maxKeyLength = std::max<uint64_t>(stats.maxKeyLength, key.length());
+	return key;
+}
+
+std::string generateValue(const GeneratorConfig& cfg, const std::string& type, Rng& rng, GeneratorStats& stats)
+{
+	const uint32_t arrayLength = 1 + rng() % cfg.maxArrayLength;
+	stats.values += arrayLength;
+
+	std::string value;
+	if(type == "CHAR")
+	{
+		value += "\"";
+		for(uint32_t i = 0; i < arrayLength; ++i)
+		{
+			value += (i ? " " : "") + CHAR_WORDS[rng() % CHAR_WORDS.size()];
+		}
+		return value + "\"";
+	}
+
+	// Keep every value inside the range of its type, S64/U64 values are limited to 48 bits
+	const bool isSigned = type.front() == 'S';
+	const uint32_t bits = std::min(48ul, std::stoul(type.substr(1)));
+	const uint64_t maxMagnitude = (isSigned ? (1ull << (bits - 1)) : (1ull << bits)) - 1;
+
+	for(uint32_t i = 0; i < arrayLength; ++i)
+	{
+		// Real DBs are dominated by small values, only a few use the full range of the type
+		const uint64_t limit = (rng() % 8) ? std::min<uint64_t>(maxMagnitude, 100) : maxMagnitude;
+		const uint64_t magnitude = rng() % (limit + 1);
+		value += i ? ", " : "";
+
+		if(!isSigned && rng() % 100 < cfg.hexPercent)
+		{
+			std::stringstream ss;
+			ss << "0x" << std::uppercase << std::hex << magnitude;
+			value += ss.str();
+			++stats.hexValues;
+		}
+		else if(isSigned && (rng() % 2))
+		{
+			value += "-" + std::to_string(magnitude);
+		}
+		else
+		{
+			value += std::to_string(magnitude);
+		}
+	}
+
+	return value;
+}
+
+std::string generateTaggedValue(const GeneratorConfig& cfg, const std::string& type, uint32_t index, Rng& rng, GeneratorStats& stats)
+{
+	// Tags and generations stay within the positive range of the smallest type of their size, so they are written as is
+	const uint64_t range = (type == "U8" || type == "S8") ? 100 : (type == "U16" || type == "S16") ? 30000 : 1000000000;
+	const uint64_t generation = rng() % range;
+	stats.values += cfg.maxArrayLength;
+
+	if(type == "CHAR")
+	{
+		std::string value = "\"k" + std::to_string(index);
+		for(uint32_t i = 1; i < cfg.maxArrayLength; ++i) value += " g" + std::to_string(generation);
+		return value + "\"";
+	}
+
+	std::string value = std::to_string(index % range);
+	for(uint32_t i = 1; i < cfg.maxArrayLength; ++i) value += ", " + std::to_string(generation);
+	return value;
+}
+
+std::string generateComment(uint32_t index, Rng& rng)
+{
+	std::string comment = "/* --------------------------- Section " + std::to_string(index) + " --------------------------- */\n";
+	const uint64_t numberOfLines = rng() % 3;
+	for(uint64_t i = 0; i < numberOfLines; ++i)
+	{
+		const std::string resolution = std::to_string(1 + rng() % 9);
+		comment += "/* Resolution: 0." + resolution + " unit, see " + LEAF_WORDS[rng() % LEAF_WORDS.size()] + " spec */\n";
+	}
+	return comment;
+}
@@ -1,9 +1,15 @@
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <iomanip>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <cstdint>
 #include <cstring>
+#include <cerrno>
+#include <climits>
 #include <unistd.h>
 
 static uint32_t crc16Table[256] = 
@@ -42,6 +48,10 @@ static uint32_t crc16Table[256] =
 	0xFBCF, 0xEA46, 0xD8DD, 0xC954, 0xBDEB, 0xAC62, 0x9EF9, 0x8F70
 };
 
+// Revision 11: each entry references its "value" by a 4-byte offset into a value pool placed after all entries,
+// so identical values are stored only once. Revision 10 (values inlined in each entry) is still readable by dbloader.
+static const char DB_REVISION = 11;
+
 enum class DbTypeEnum
 {
 	TYPE_OF_ENTRY_UNDEFINED	= 0,
@@ -71,27 +81,35 @@ struct DbEntry
 	std::string value;
 };
 
-void constructBinaryFile(const std::vector<char>& payload, std::ofstream& binFile);
+void constructBinaryFile(const std::vector<char>& payload, uint32_t totalEntryBytes, std::ostream& binFile);
+void constructEmbeddedSource(const std::string& image, uint64_t checksum, const std::string& headerFileName, const std::string& txtFilePath, std::ofstream& sourceFile);
+void constructAccessorHeader(const std::vector<std::string>& entries, uint64_t checksum, const std::string& txtFilePath, std::ofstream& headerFile);
 uint32_t lookupCRC16Table(uint32_t initCRC, uint8_t data);
 uint16_t getCRC16(uint8_t *startAddr, uint32_t numberBytes);
+uint64_t getContentHash(const uint8_t *startAddr, uint32_t numberBytes);
 bool tokenize(const char*& p, std::string& token, uint8_t index);
-std::vector<char> generatePayload(const std::vector<std::string>& entries);
+DbEntry parseEntry(const std::string& e);
+std::vector<char> generatePayload(const std::vector<std::string>& entries, uint32_t& totalEntryBytes);
 std::vector<std::string> convertDBEntries(std::ifstream& txtFile);
 
 
-/* Format: ./textToBin -i <abs_path_to_txt_DB_file> -o <abs_path_to_bin_DB_file> -e 		*/
+/* Format: ./textToBin -i <abs_path_to_txt_DB_file> -o <abs_path_to_bin_DB_file> [-c <abs_path_to_cc_file>] [-g <abs_path_to_h_file>] -e	*/
 /* Options:											*/
 /* 	+ i: absolute path to the text-based database file					*/
 /* 	+ o: absolute path to the converted binary database file				*/
+/* 	+ c: absolute path to a C++ source embedding the binary database					*/
+/* 	+ g: absolute path to a C++ header with one typed accessor per key, at least one of -o, -c and -g	*/
 /*	+ e: is binary database file encrypted?							*/ 
 int main(int argc, char* argv[])
 {
 	int opt = 0;
 	std::string txtFilePath {""};
 	std::string binFilePath {""};
+	std::string sourceFilePath {""};
+	std::string headerFilePath {""};
 	bool isEncrypted = false;
 
-	while((opt = getopt(argc, argv, "i:o:e")) != -1)
+	while((opt = getopt(argc, argv, "i:o:c:g:e")) != -1)
 	{
 		switch (opt)
 		{
@@ -102,16 +120,26 @@ int main(int argc, char* argv[])
 		case 'o':
 			binFilePath = std::string(optarg);
 			break;
+
+		case 'c':
+			sourceFilePath = std::string(optarg);
+			break;
+
+		case 'g':
+			headerFilePath = std::string(optarg);
+			break;
 		
 		case 'e':
 			isEncrypted = true;
 			break;
 		default:
 			std::cout << "ERROR:\n";
-			std::cout << "\tUsage:  " << argv[0] << "-i <abs_path_to_txt_DB_file> -o <abs_path_to_bin_DB_file> -e\n";
+			std::cout << "\tUsage:  " << argv[0] << "-i <abs_path_to_txt_DB_file> -o <abs_path_to_bin_DB_file> -c <abs_path_to_cc_file> -g <abs_path_to_h_file> -e\n";
 			std::cout << "\tOption:\n";
 			std::cout << "\t\t -i : absolute path to the text-based database file.\n";
 			std::cout << "\t\t -o : absolute path to the converted binary database file.\n";
+			std::cout << "\t\t -c : absolute path to a C++ source embedding the converted binary database, link it to load the DB without file I/O.\n";
+			std::cout << "\t\t -g : absolute path to a C++ header with one typed accessor per key, bound to the entry id instead of the key.\n";
 			std::cout << "\t\t -e : is the converted binary database file's content encrypted?\n";
 			exit(EXIT_FAILURE);
 			break;
@@ -120,7 +148,7 @@ int main(int argc, char* argv[])
 
 	(void)isEncrypted;
 
-	if(txtFilePath.empty() || binFilePath.empty())
+	if(txtFilePath.empty() || (binFilePath.empty() && sourceFilePath.empty() && headerFilePath.empty()))
 	{
 		std::cout << "ERROR: Empty file path given, double check execute command!" << std::endl;
 		exit(EXIT_FAILURE);
@@ -134,23 +162,59 @@ int main(int argc, char* argv[])
 		exit(EXIT_FAILURE);
 	}
 
-	std::ofstream binFile(binFilePath, std::ios_base::binary);
-	if(!binFile.is_open())
+	std::vector<std::string> entries = convertDBEntries(txtFile);
+	txtFile.close();
+
+	uint32_t totalEntryBytes = 0;
+	std::vector<char> payload = generatePayload(entries, totalEntryBytes);
+	const uint64_t checksum = getContentHash((const uint8_t *)payload.data(), payload.size());
+
+	if(!binFilePath.empty())
 	{
-		// ERROR TRACE
-		std::cout << "ERROR: Failed to open file: " << binFilePath << std::endl;
-		exit(EXIT_FAILURE);
+		std::ofstream binFile(binFilePath, std::ios_base::binary);
+		if(!binFile.is_open())
+		{
+			// ERROR TRACE
+			std::cout << "ERROR: Failed to open file: " << binFilePath << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		constructBinaryFile(payload, totalEntryBytes, binFile);
+		binFile.close();
 	}
 
-	
-	std::vector<std::string> entries = convertDBEntries(txtFile);
+	if(!sourceFilePath.empty())
+	{
+		std::ofstream sourceFile(sourceFilePath);
+		if(!sourceFile.is_open())
+		{
+			// ERROR TRACE
+			std::cout << "ERROR: Failed to open file: " << sourceFilePath << std::endl;
+			exit(EXIT_FAILURE);
+		}
 
-	std::vector<char> payload = generatePayload(entries);
+		// Byte for byte the same image as swdb.bin
+		std::ostringstream image;
+		constructBinaryFile(payload, totalEntryBytes, image);
+		// The accessors are looked up next to the source, under the name given to -g or the one make accessors uses
+		const std::string headerFileName = headerFilePath.empty() ? "swdbAccessors.h" : headerFilePath.substr(headerFilePath.rfind('/') + 1);
+		constructEmbeddedSource(image.str(), checksum, headerFileName, txtFilePath, sourceFile);
+		sourceFile.close();
+	}
 
-	constructBinaryFile(payload, binFile);
+	if(!headerFilePath.empty())
+	{
+		std::ofstream headerFile(headerFilePath);
+		if(!headerFile.is_open())
+		{
+			// ERROR TRACE
+			std::cout << "ERROR: Failed to open file: " << headerFilePath << std::endl;
+			exit(EXIT_FAILURE);
+		}
 
-	txtFile.close();
-	binFile.close();
+		constructAccessorHeader(entries, checksum, txtFilePath, headerFile);
+		headerFile.close();
+	}
 
 	exit(EXIT_SUCCESS);
 }
@@ -214,25 +278,16 @@ std::vector<std::string> convertDBEntries(std::ifstream& txtFile)
 	return entryVec;
 }
 
-std::vector<char> generatePayload(const std::vector<std::string>& entries)
+std::vector<char> generatePayload(const std::vector<std::string>& entries, uint32_t& totalEntryBytes)
 {
 	std::vector<char> payload;
+	std::vector<char> valuePool;
+	std::unordered_map<std::string, uint32_t> valueOffsets; // Content hash of every "value" already in valuePool
+	std::size_t totalValueBytes = 0;
 
 	for(const auto& e : entries)
 	{
-		DbEntry entry;
-		std::string token;
-		const char *p = e.c_str();
-		uint8_t index = 0;
-		while(tokenize(p, token, index))
-		{
-			if(index == 0) entry.key = token;
-			else if(index == 1) entry.permission = token;
-			else if(index == 2) entry.type = token;
-			else if(index == 3) entry.value = token;
-
-			if(++index > 3) break;
-		}
+		const DbEntry entry = parseEntry(e);
 
 		payload.push_back('F');
 
@@ -255,13 +310,47 @@ std::vector<char> generatePayload(const std::vector<std::string>& entries)
 		else payload.push_back(static_cast<char>(DbTypeEnum::TYPE_OF_ENTRY_UNDEFINED));
 
 		// std::cout << "entry.value: " << entry.value << ", length: " << entry.value.length() << std::endl;
-		for(const auto& c : entry.value) payload.push_back(c);
-		payload.push_back('\0');
+		totalValueBytes += entry.value.length() + 1;
+		auto it = valueOffsets.find(entry.value);
+		if(it == valueOffsets.end())
+		{
+			it = valueOffsets.emplace(entry.value, valuePool.size()).first;
+			for(const auto& c : entry.value) valuePool.push_back(c);
+			valuePool.push_back('\0');
+		}
+
+		uint32_t valueOffset = htobe32(it->second);
+		for(int i = 0; i < 4; ++i) payload.push_back(*((char *)(&valueOffset) + i)); // Offset of "value" in the value pool
 	}
 
+	totalEntryBytes = payload.size();
+	payload.insert(payload.end(), valuePool.begin(), valuePool.end());
+
+	std::cout << "INFO: " << entries.size() << " entries, " << valueOffsets.size() << " unique values, value pool "
+		<< valuePool.size() << " bytes instead of " << totalValueBytes << " bytes" << std::endl;
+
 	return payload;
 }
 
+DbEntry parseEntry(const std::string& e)
+{
+	DbEntry entry;
+	std::string token;
+	const char *p = e.c_str();
+	uint8_t index = 0;
+	while(tokenize(p, token, index))
+	{
+		if(index == 0) entry.key = token;
+		else if(index == 1) entry.permission = token;
+		else if(index == 2) entry.type = token;
+		else if(index == 3) entry.value = token;
+
+		if(++index > 3) break;
+	}
+
+	return entry;
+}
+
 bool tokenize(const char*& p, std::string& token, uint8_t index)
 {
 	// Remove " \t" from front
@@ -324,15 +413,219 @@ uint16_t getCRC16(uint8_t *startAddr, uint32_t numberBytes)
 	return (tmp ^ 0xFFFF) & 0xFFFF;
 }
 
-void constructBinaryFile(const std::vector<char>& payload, std::ofstream& binFile)
+uint64_t getContentHash(const uint8_t *startAddr, uint32_t numberBytes)
+{
+	// 64-bit FNV-1a of the payload, dbloader computes the same at load as LoadStats::checksum
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for(const uint8_t *currentAddr = startAddr; currentAddr < startAddr + numberBytes; ++currentAddr)
+	{
+		hash = (hash ^ *currentAddr) * 0x100000001B3ull;
+	}
+
+	return hash;
+}
+
+void constructBinaryFile(const std::vector<char>& payload, uint32_t totalEntryBytes, std::ostream& binFile)
 {
 	binFile.put('H'); // DB Header Tag
-	binFile.put((char)10); // DB revision, currently hardcoded
-	for(int i = 0; i < 4; ++i) binFile.put((char)0); // Reserved 4 bytes for additional DB parameters
+	binFile.put(DB_REVISION); // DB revision
+	totalEntryBytes = htobe32(totalEntryBytes);
+	for(int i = 0; i < 4; ++i) binFile.put(*((char *)(&totalEntryBytes) + i)); // Reserved 4 bytes for additional DB parameters, total bytes of all DB entries before the value pool
 	uint32_t totalPayloadBytes = htobe32(payload.size());
 	for(int i = 0; i < 4; ++i) binFile.put(*((char *)(&totalPayloadBytes) + i)); // Total bytes of payload (all DB entries)
 	for(const auto& c : payload) binFile.put(c); // Write DB payload (converted DB entries)
 	binFile.put('E'); // DB End Tag
 	uint16_t crc16 = htobe16(getCRC16((uint8_t *)payload.data(), payload.size()));
 	for(int i = 0; i < 2; ++i) binFile.put(*((char *)(&crc16) + i)); // CRC16 Checksum
-}
\ No newline at end of file
+}
+
+void constructEmbeddedSource(const std::string& image, uint64_t checksum, const std::string& headerFileName, const std::string& txtFilePath, std::ofstream& sourceFile)
+{
+	// The image lands in .rodata: its pages are only faulted in when DbLoader reads them and are shared by all processes of the executable.
+	// Both symbols have C linkage, DbLoader refers to them as weak symbols and loads swdb.bin when they are not linked in.
+	sourceFile << "// Generated by textToBin from " << txtFilePath << ", do not edit\n";
+	sourceFile << "#include <cstddef>\n#include <cstdint>\n\n";
+
+	// Accessors generated from another DB would read other entries by their ids, which this image turns into a build error
+	sourceFile << "// 64-bit FNV-1a hash of the payload of this image, the DB_CHECKSUM of accessors generated from the same DB\n";
+	sourceFile << "constexpr uint64_t SWDB_IMAGE_CHECKSUM = 0x" << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << "ull;\n\n";
+	sourceFile << "#if __has_include(\"" << headerFileName << "\")\n";
+	sourceFile << "#include \"" << headerFileName << "\"\n";
+	sourceFile << "static_assert(db::DB_CHECKSUM == SWDB_IMAGE_CHECKSUM, \"" << headerFileName
+		<< " was generated from another DB than this image, regenerate both from the same text DB\");\n";
+	sourceFile << "#endif\n\n";
+	sourceFile << "extern \"C\" alignas(64) const unsigned char dbengine_swdb_image[" << image.size() << "] =\n{\n";
+	sourceFile << std::hex << std::setfill('0');
+	for(std::size_t i = 0; i < image.size(); ++i)
+	{
+		if(i % 16 == 0) sourceFile << "\t";
+		sourceFile << "0x" << std::setw(2) << static_cast<uint32_t>(static_cast<uint8_t>(image[i])) << ",";
+		sourceFile << ((i % 16 == 15 || i + 1 == image.size()) ? "\n" : " ");
+	}
+	sourceFile << std::dec;
+	sourceFile << "};\n\n";
+	sourceFile << "extern \"C\" const std::size_t dbengine_swdb_image_size = sizeof(dbengine_swdb_image);\n";
+}
+
+// C++ type of a numeric DB type and the range dbloader accepts for it (values are converted by std::stoll)
+struct NumericType
+{
+	const char* name;
+	const char* cppType;
+	long long min;
+	long long max;
+};
+
+static const NumericType numericTypes[] =
+{
+	{"U8", "uint8_t", 0, UINT8_MAX},
+	{"S8", "int8_t", INT8_MIN, INT8_MAX},
+	{"U16", "uint16_t", 0, UINT16_MAX},
+	{"S16", "int16_t", INT16_MIN, INT16_MAX},
+	{"U32", "uint32_t", 0, UINT32_MAX},
+	{"S32", "int32_t", INT32_MIN, INT32_MAX},
+	{"U64", "uint64_t", 0, LLONG_MAX},
+	{"S64", "int64_t", LLONG_MIN, LLONG_MAX},
+};
+
+static const std::unordered_set<std::string> cppKeywords =
+{
+	"alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char", "char16_t",
+	"char32_t", "class", "compl", "const", "constexpr", "const_cast", "continue", "decltype", "default", "delete", "do", "double",
+	"dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+	"long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected",
+	"public", "register", "reinterpret_cast", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast",
+	"struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+	"unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
+};
+
+// Sub-key as a C++ identifier: every other character than [A-Za-z0-9_] becomes '_', e.g. prod_1.14.12 gives prod_1_14_12
+static std::string toIdentifier(const std::string& subKey)
+{
+	std::string identifier;
+	for(const auto& c : subKey) identifier += (isalnum(static_cast<unsigned char>(c)) || c == '_') ? c : '_';
+
+	if(identifier.empty() || isdigit(static_cast<unsigned char>(identifier.front())) || cppKeywords.count(identifier)) identifier.insert(0, "_");
+	return identifier;
+}
+
+// Number of values dbloader will parse from a numeric "value", false if it would drop any of them
+static bool countNumericValues(const std::string& value, const NumericType& type, std::size_t& count)
+{
+	count = 0;
+	std::stringstream values(value);
+	std::string token;
+	while(std::getline(values, token, ','))
+	{
+		const auto first = token.find_first_not_of(" \t");
+		if(first == std::string::npos) continue;
+		token = token.substr(first, token.find_last_not_of(" \t") - first + 1);
+
+		char* end = nullptr;
+		errno = 0;
+		const long long numeric = strtoll(token.c_str(), &end, token.find("0x") != std::string::npos ? 16 : 10);
+		if(errno != 0 || *end != '\0' || numeric < type.min || numeric > type.max) return false;
+
+		++count;
+	}
+
+	return true;
+}
+
+void constructAccessorHeader(const std::vector<std::string>& entries, uint64_t checksum, const std::string& txtFilePath, std::ofstream& headerFile)
+{
+	// The id of an entry is its position in the payload, which is the order dbloader stores the Original DB in
+	static const std::string dbIf = "::DbEngine::DatabaseIf::V1";
+
+	headerFile << "// Generated by textToBin from " << txtFilePath << ", do not edit\n";
+	headerFile << "#pragma once\n\n";
+	headerFile << "#include <array>\n#include <cstddef>\n#include <cstdint>\n#include <optional>\n\n#include \"databaseIf.h\"\n\n";
+	headerFile << "namespace db\n{\n\n";
+	headerFile << "// 64-bit FNV-1a hash of the DB these accessors were generated from, any other DB gives their ids to other entries.\n";
+	headerFile << "// Every accessor passes it along with its id, so that they return DB_MISMATCH or std::nullopt on another DB.\n";
+	headerFile << "// An embedded image (textToBin -c) static_asserts that it is its own SWDB_IMAGE_CHECKSUM, a loaded swdb.bin is checked at runtime only.\n";
+	headerFile << "inline constexpr uint64_t DB_CHECKSUM = 0x" << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << "ull;\n\n";
+	headerFile << "inline bool isLoadedDbMatching()\n{\n";
+	headerFile << "\treturn " << dbIf << "::IDatabase::getInstance().loadStats().checksum == DB_CHECKSUM;\n}\n";
+
+	// Nested namespaces and accessors share one scope, a name may only be taken by one of them
+	std::unordered_set<std::string> namespaces;
+	std::unordered_set<std::string> accessors;
+	std::string openNamespace;
+	std::size_t numberOfAccessors = 0;
+
+	for(std::size_t id = 0; id < entries.size(); ++id)
+	{
+		const DbEntry entry = parseEntry(entries[id]);
+
+		std::vector<std::string> names;
+		std::stringstream subKeys(entry.key);
+		std::string subKey;
+		while(std::getline(subKeys, subKey, '/'))
+		{
+			if(!subKey.empty()) names.push_back(toIdentifier(subKey));
+		}
+		if(names.empty()) continue;
+
+		std::string scope;
+		bool isClashing = false;
+		for(std::size_t i = 0; i + 1 < names.size(); ++i)
+		{
+			scope += (scope.empty() ? "" : "::") + names[i];
+			isClashing = isClashing || accessors.count(scope);
+		}
+		const std::string name = (scope.empty() ? "" : scope + "::") + names.back();
+		if(isClashing || accessors.count(name) || namespaces.count(name))
+		{
+			std::cout << "WARNING: No accessor for " << entry.key << ", its name " << name << " is taken already" << std::endl;
+			continue;
+		}
+
+		const NumericType* numericType = nullptr;
+		for(const auto& type : numericTypes)
+		{
+			if(entry.type == type.name) numericType = &type;
+		}
+
+		std::size_t count = 0;
+		if(entry.type != "CHAR" && (numericType == nullptr || !countNumericValues(entry.value, *numericType, count) || count == 0))
+		{
+			std::cout << "WARNING: No accessor for " << entry.key << ", its type or value is not valid" << std::endl;
+			continue;
+		}
+
+		for(std::size_t pos = scope.find("::"); pos != std::string::npos; pos = scope.find("::", pos + 2)) namespaces.insert(scope.substr(0, pos));
+		if(!scope.empty()) namespaces.insert(scope);
+		accessors.insert(name);
+
+		if(scope != openNamespace)
+		{
+			if(!openNamespace.empty()) headerFile << "\n} // namespace " << openNamespace << "\n";
+			if(!scope.empty()) headerFile << "\nnamespace " << scope << "\n{\n";
+			openNamespace = scope;
+		}
+
+		headerFile << "\n// " << entry.key << "\t" << entry.permission << "\t" << entry.type << "\n";
+		if(numericType == nullptr)
+		{
+			headerFile << "inline " << dbIf << "::ReturnCodeEnum " << names.back() << "(char* value, std::size_t capacity, std::size_t& length)\n{\n";
+			headerFile << "\treturn " << dbIf << "::IDatabase::getInstance().getById({" << id << ", DB_CHECKSUM}, value, capacity, length);\n}\n";
+		}
+		else if(count == 1)
+		{
+			headerFile << "inline std::optional<" << numericType->cppType << "> " << names.back() << "() noexcept\n{\n";
+			headerFile << "\treturn " << dbIf << "::IDatabase::getInstance().autoGetById<" << numericType->cppType << ">({" << id << ", DB_CHECKSUM});\n}\n";
+		}
+		else
+		{
+			headerFile << "inline std::optional<std::array<" << numericType->cppType << ", " << count << ">> " << names.back() << "() noexcept\n{\n";
+			headerFile << "\treturn " << dbIf << "::IDatabase::getInstance().autoGetArrayById<" << numericType->cppType << ", " << count << ">({" << id << ", DB_CHECKSUM});\n}\n";
+		}
+		++numberOfAccessors;
+	}
+
+	if(!openNamespace.empty()) headerFile << "\n} // namespace " << openNamespace << "\n";
+	headerFile << "\n} // namespace db\n";
+
+	std::cout << "INFO: " << numberOfAccessors << " accessors for " << entries.size() << " entries" << std::endl;
+}
@@ -0,0 +1,67 @@
+// Generated by textToBin from ./swdb/swdb.txt, do not edit
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit FNV-1a hash of the payload of this image, the DB_CHECKSUM of accessors generated from the same DB
+constexpr uint64_t SWDB_IMAGE_CHECKSUM = 0x38be62e6431641f9ull;
+
+#if __has_include("swdbAccessors.h")
+#include "swdbAccessors.h"
+static_assert(db::DB_CHECKSUM == SWDB_IMAGE_CHECKSUM, "swdbAccessors.h was generated from another DB than this image, regenerate both from the same text DB");
+#endif
+
+extern "C" alignas(64) const unsigned char dbengine_swdb_image[792] =
+{
+	0x48, 0x0b, 0x00, 0x00, 0x02, 0x49, 0x00, 0x00, 0x03, 0x0b, 0x46, 0x2f, 0x73, 0x77, 0x2f, 0x70,
+	0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x69, 0x73, 0x46, 0x65,
+	0x61, 0x74, 0x75, 0x72, 0x65, 0x58, 0x79, 0x7a, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x00,
+	0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x46, 0x2f, 0x68, 0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f,
+	0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x2f, 0x61,
+	0x64, 0x35, 0x31, 0x78, 0x32, 0x2f, 0x74, 0x65, 0x6d, 0x70, 0x65, 0x72, 0x61, 0x74, 0x75, 0x72,
+	0x65, 0x52, 0x61, 0x6e, 0x67, 0x65, 0x73, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 0x02, 0x46, 0x2f,
+	0x68, 0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f,
+	0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x2f, 0x61, 0x64, 0x35, 0x31, 0x78, 0x32, 0x2f, 0x64, 0x72,
+	0x69, 0x76, 0x65, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x00, 0x01, 0x09, 0x00, 0x00, 0x00, 0x17, 0x46,
+	0x2f, 0x73, 0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32,
+	0x2f, 0x73, 0x75, 0x70, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x43, 0x61, 0x70, 0x61, 0x62, 0x69,
+	0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x2f, 0x46, 0x2f, 0x68,
+	0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x73,
+	0x75, 0x70, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x50, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c,
+	0x73, 0x00, 0x02, 0x09, 0x00, 0x00, 0x00, 0x33, 0x46, 0x2f, 0x73, 0x77, 0x2f, 0x70, 0x72, 0x6f,
+	0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x69, 0x73, 0x46, 0x65, 0x61, 0x74,
+	0x75, 0x72, 0x65, 0x55, 0x73, 0x74, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x00, 0x02, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x46, 0x2f, 0x68, 0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e,
+	0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x2f, 0x61, 0x64, 0x72,
+	0x66, 0x36, 0x37, 0x39, 0x35, 0x2f, 0x70, 0x6f, 0x77, 0x65, 0x72, 0x52, 0x61, 0x6e, 0x67, 0x65,
+	0x73, 0x00, 0x01, 0x03, 0x00, 0x00, 0x00, 0x42, 0x46, 0x2f, 0x68, 0x77, 0x2f, 0x70, 0x72, 0x6f,
+	0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72,
+	0x2f, 0x61, 0x64, 0x72, 0x66, 0x36, 0x37, 0x39, 0x35, 0x2f, 0x64, 0x72, 0x69, 0x76, 0x65, 0x72,
+	0x4e, 0x61, 0x6d, 0x65, 0x00, 0x01, 0x09, 0x00, 0x00, 0x00, 0x52, 0x46, 0x2f, 0x68, 0x77, 0x2f,
+	0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x69, 0x6e, 0x69,
+	0x74, 0x53, 0x65, 0x71, 0x75, 0x65, 0x6e, 0x63, 0x65, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x66,
+	0x46, 0x2f, 0x68, 0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31,
+	0x32, 0x2f, 0x66, 0x61, 0x6e, 0x2f, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x2f, 0x64, 0x75, 0x74, 0x79,
+	0x43, 0x79, 0x63, 0x6c, 0x65, 0x73, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x97, 0x46, 0x2f, 0x68,
+	0x77, 0x2f, 0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x62,
+	0x6f, 0x61, 0x72, 0x64, 0x2f, 0x66, 0x61, 0x6e, 0x2f, 0x64, 0x75, 0x74, 0x79, 0x43, 0x79, 0x63,
+	0x6c, 0x65, 0x73, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0xa2, 0x46, 0x2f, 0x68, 0x77, 0x2f, 0x70,
+	0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x66, 0x61, 0x6e, 0x53,
+	0x70, 0x65, 0x65, 0x64, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0xad, 0x46, 0x2f, 0x68, 0x77, 0x2f,
+	0x70, 0x72, 0x6f, 0x64, 0x5f, 0x31, 0x2e, 0x31, 0x34, 0x2e, 0x31, 0x32, 0x2f, 0x66, 0x61, 0x6e,
+	0x53, 0x70, 0x65, 0x65, 0x64, 0x2f, 0x6c, 0x69, 0x6d, 0x69, 0x74, 0x73, 0x00, 0x02, 0x03, 0x00,
+	0x00, 0x00, 0xb8, 0x31, 0x00, 0x2d, 0x31, 0x30, 0x30, 0x2c, 0x20, 0x32, 0x30, 0x35, 0x2c, 0x20,
+	0x31, 0x31, 0x30, 0x30, 0x2c, 0x20, 0x31, 0x35, 0x35, 0x00, 0x22, 0x74, 0x65, 0x6d, 0x70, 0x53,
+	0x65, 0x6e, 0x73, 0x6f, 0x72, 0x44, 0x63, 0x44, 0x63, 0x3a, 0x76, 0x31, 0x2e, 0x30, 0x2e, 0x31,
+	0x22, 0x00, 0x30, 0x78, 0x45, 0x00, 0x22, 0x53, 0x50, 0x49, 0x20, 0x49, 0x32, 0x43, 0x20, 0x55,
+	0x41, 0x52, 0x54, 0x22, 0x00, 0x34, 0x35, 0x2c, 0x20, 0x36, 0x30, 0x2c, 0x20, 0x38, 0x30, 0x2c,
+	0x20, 0x31, 0x30, 0x30, 0x00, 0x22, 0x70, 0x6f, 0x77, 0x65, 0x72, 0x41, 0x6d, 0x70, 0x31, 0x2e,
+	0x30, 0x3a, 0x76, 0x31, 0x2e, 0x31, 0x31, 0x22, 0x00, 0x31, 0x2c, 0x20, 0x35, 0x2c, 0x20, 0x32,
+	0x2c, 0x20, 0x33, 0x2c, 0x20, 0x34, 0x2c, 0x09, 0x31, 0x31, 0x2c, 0x20, 0x31, 0x33, 0x2c, 0x20,
+	0x32, 0x35, 0x2c, 0x20, 0x32, 0x31, 0x2c, 0x20, 0x31, 0x39, 0x2c, 0x09, 0x37, 0x2c, 0x20, 0x35,
+	0x2c, 0x20, 0x33, 0x2c, 0x20, 0x32, 0x2c, 0x20, 0x31, 0x00, 0x33, 0x30, 0x2c, 0x20, 0x36, 0x30,
+	0x2c, 0x20, 0x39, 0x30, 0x00, 0x32, 0x30, 0x2c, 0x20, 0x34, 0x30, 0x2c, 0x20, 0x38, 0x30, 0x00,
+	0x31, 0x32, 0x30, 0x30, 0x2c, 0x20, 0x32, 0x34, 0x30, 0x30, 0x00, 0x36, 0x30, 0x30, 0x2c, 0x20,
+	0x33, 0x30, 0x30, 0x30, 0x00, 0x45, 0xdc, 0x89,
+};
+
+extern "C" const std::size_t dbengine_swdb_image_size = sizeof(dbengine_swdb_image);
@@ -0,0 +1,146 @@
+// Generated by textToBin from ./swdb/swdb.txt, do not edit
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "databaseIf.h"
+
+namespace db
+{
+
+// 64-bit FNV-1a hash of the DB these accessors were generated from, any other DB gives their ids to other entries.
+// Every accessor passes it along with its id, so that they return DB_MISMATCH or std::nullopt on another DB.
+// An embedded image (textToBin -c) static_asserts that it is its own SWDB_IMAGE_CHECKSUM, a loaded swdb.bin is checked at runtime only.
+inline constexpr uint64_t DB_CHECKSUM = 0x38be62e6431641f9ull;
+
+inline bool isLoadedDbMatching()
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().loadStats().checksum == DB_CHECKSUM;
+}
+
+namespace sw::prod_1_14_12
+{
+
+// /sw/prod_1.14.12/isFeatureXyzEnabled	RW	U8
+inline std::optional<uint8_t> isFeatureXyzEnabled() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetById<uint8_t>({0, DB_CHECKSUM});
+}
+
+} // namespace sw::prod_1_14_12
+
+namespace hw::prod_1_14_12::sensor::ad51x2
+{
+
+// /hw/prod_1.14.12/sensor/ad51x2/temperatureRanges	R	S16
+inline std::optional<std::array<int16_t, 4>> temperatureRanges() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<int16_t, 4>({1, DB_CHECKSUM});
+}
+
+// /hw/prod_1.14.12/sensor/ad51x2/driverName	R	CHAR
+inline ::DbEngine::DatabaseIf::V1::ReturnCodeEnum driverName(char* value, std::size_t capacity, std::size_t& length)
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().getById({2, DB_CHECKSUM}, value, capacity, length);
+}
+
+} // namespace hw::prod_1_14_12::sensor::ad51x2
+
+namespace sw::prod_1_14_12
+{
+
+// /sw/prod_1.14.12/supportedCapabilities	RW	U16
+inline std::optional<uint16_t> supportedCapabilities() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetById<uint16_t>({3, DB_CHECKSUM});
+}
+
+} // namespace sw::prod_1_14_12
+
+namespace hw::prod_1_14_12
+{
+
+// /hw/prod_1.14.12/supportedProtocols	RW	CHAR
+inline ::DbEngine::DatabaseIf::V1::ReturnCodeEnum supportedProtocols(char* value, std::size_t capacity, std::size_t& length)
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().getById({4, DB_CHECKSUM}, value, capacity, length);
+}
+
+} // namespace hw::prod_1_14_12
+
+namespace sw::prod_1_14_12
+{
+
+// /sw/prod_1.14.12/isFeatureUstEnabled	RW	U8
+inline std::optional<uint8_t> isFeatureUstEnabled() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetById<uint8_t>({5, DB_CHECKSUM});
+}
+
+} // namespace sw::prod_1_14_12
+
+namespace hw::prod_1_14_12::sensor::adrf6795
+{
+
+// /hw/prod_1.14.12/sensor/adrf6795/powerRanges	R	U16
+inline std::optional<std::array<uint16_t, 4>> powerRanges() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<uint16_t, 4>({6, DB_CHECKSUM});
+}
+
+// /hw/prod_1.14.12/sensor/adrf6795/driverName	R	CHAR
+inline ::DbEngine::DatabaseIf::V1::ReturnCodeEnum driverName(char* value, std::size_t capacity, std::size_t& length)
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().getById({7, DB_CHECKSUM}, value, capacity, length);
+}
+
+} // namespace hw::prod_1_14_12::sensor::adrf6795
+
+namespace hw::prod_1_14_12
+{
+
+// /hw/prod_1.14.12/initSequence	RW	U8
+inline std::optional<std::array<uint8_t, 15>> initSequence() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<uint8_t, 15>({8, DB_CHECKSUM});
+}
+
+} // namespace hw::prod_1_14_12
+
+namespace hw::prod_1_14_12::fan::board
+{
+
+// /hw/prod_1.14.12/fan/board/dutyCycles	RW	U16
+inline std::optional<std::array<uint16_t, 3>> dutyCycles() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<uint16_t, 3>({9, DB_CHECKSUM});
+}
+
+} // namespace hw::prod_1_14_12::fan::board
+
+namespace hw::prod_1_14_12::board::fan
+{
+
+// /hw/prod_1.14.12/board/fan/dutyCycles	RW	U16
+inline std::optional<std::array<uint16_t, 3>> dutyCycles() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<uint16_t, 3>({10, DB_CHECKSUM});
+}
+
+} // namespace hw::prod_1_14_12::board::fan
+
+namespace hw::prod_1_14_12
+{
+
+// /hw/prod_1.14.12/fanSpeed	RW	U16
+inline std::optional<std::array<uint16_t, 2>> fanSpeed() noexcept
+{
+	return ::DbEngine::DatabaseIf::V1::IDatabase::getInstance().autoGetArrayById<uint16_t, 2>({11, DB_CHECKSUM});
+}
+
+} // namespace hw::prod_1_14_12
+
+} // namespace db